@@ -1,7 +1,17 @@
+#include "AsyncConsumer.hpp"
+#include "AsyncPublisher.hpp"
 #include "ChannelId.hpp"
 #include "Consumer.hpp"
+#include "DeliveryMetadata.hpp"
+#include "DeliveryReport.hpp"
+#include "Executor.hpp"
 #include "Header.hpp"
+#include "HeaderId.hpp"
+#include "HeaderList.hpp"
 #include "Message.hpp"
 #include "Messenger.hpp"
 #include "Payload.hpp"
-#include "Publisher.hpp"
\ No newline at end of file
+#include "PayloadBuffer.hpp"
+#include "PublishBatchResult.hpp"
+#include "Publisher.hpp"
+#include "RecordHeaders.hpp"
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "AsyncConsumer.hpp"
+
+#include "Exceptions.hpp"
+
+#include <algorithm>
+
+namespace assfire::messenger {
+
+    bool AsyncConsumer::BatchAwaitable::await_ready() {
+        return try_poll();
+    }
+
+    std::vector<Message> AsyncConsumer::BatchAwaitable::await_resume() {
+        if (_messages.empty()) { throw EndOfStreamError("Consumer is stopped"); }
+        return std::move(_messages);
+    }
+
+    // Stopped consumer won't receive anything more, so awaiting is over once messages received before stop are polled
+    bool AsyncConsumer::BatchAwaitable::try_poll() {
+        return _consumer._consumer->try_poll_batch(_messages, std::max<std::size_t>(_max_messages, 1)) > 0 || _consumer._consumer->stopped();
+    }
+
+    void AsyncConsumer::BatchAwaitable::await_suspend(std::coroutine_handle<> handle) {
+        wait_readable(handle);
+    }
+
+    // Messages may be taken by another poller between readability notification and this poll, then waiting starts over
+    void AsyncConsumer::BatchAwaitable::wait_readable(std::coroutine_handle<> handle) {
+        _consumer._consumer->notify_when_readable([this, handle] {
+            if (try_poll()) {
+                _consumer._executor(handle);
+            } else {
+                wait_readable(handle);
+            }
+        });
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
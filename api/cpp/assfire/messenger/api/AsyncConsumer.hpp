@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Consumer.hpp"
+#include "Executor.hpp"
+#include "Message.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace assfire::messenger {
+    // Coroutine facade over consumer: awaiting next() or next_batch() suspends coroutine without blocking any thread
+    // until messages are received and then resumes it on the executor
+    class AsyncConsumer {
+      public:
+        class BatchAwaitable {
+          public:
+            BatchAwaitable(AsyncConsumer& consumer, std::size_t max_messages) : _consumer(consumer), _max_messages(max_messages) {}
+
+            bool await_ready();
+            void await_suspend(std::coroutine_handle<> handle);
+            // Throws EndOfStreamError if consumer was stopped and there is nothing left to poll
+            std::vector<Message> await_resume();
+
+          private:
+            bool try_poll();
+            void wait_readable(std::coroutine_handle<> handle);
+
+            AsyncConsumer& _consumer;
+            std::size_t _max_messages;
+            std::vector<Message> _messages;
+        };
+
+        class MessageAwaitable {
+          public:
+            explicit MessageAwaitable(AsyncConsumer& consumer) : _batch(consumer, 1) {}
+
+            bool await_ready() {
+                return _batch.await_ready();
+            }
+            void await_suspend(std::coroutine_handle<> handle) {
+                _batch.await_suspend(handle);
+            }
+            Message await_resume() {
+                return std::move(_batch.await_resume().front());
+            }
+
+          private:
+            BatchAwaitable _batch;
+        };
+
+        AsyncConsumer(std::shared_ptr<Consumer> consumer, Executor executor) : _consumer(std::move(consumer)), _executor(std::move(executor)) {}
+
+        MessageAwaitable next() {
+            return MessageAwaitable(*this);
+        }
+
+        BatchAwaitable next_batch(std::size_t max_messages) {
+            return BatchAwaitable(*this, max_messages);
+        }
+
+        const std::shared_ptr<Consumer>& consumer() const {
+            return _consumer;
+        }
+
+      private:
+        std::shared_ptr<Consumer> _consumer;
+        Executor _executor;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
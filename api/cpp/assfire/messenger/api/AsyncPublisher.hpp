@@ -0,0 +1,58 @@
+#pragma once
+
+#include "DeliveryReport.hpp"
+#include "Executor.hpp"
+#include "Message.hpp"
+#include "Publisher.hpp"
+
+#include <coroutine>
+#include <memory>
+#include <optional>
+
+namespace assfire::messenger {
+    // Coroutine facade over publisher: awaiting publish_async() suspends coroutine until message is delivered or failed
+    // and then resumes it on the executor with delivery report
+    class AsyncPublisher {
+      public:
+        class DeliveryAwaitable {
+          public:
+            DeliveryAwaitable(AsyncPublisher& publisher, const Message& msg) : _publisher(publisher), _msg(msg) {}
+
+            bool await_ready() const {
+                return false;
+            }
+
+            // Delivery callback may resume coroutine before publish returns, so awaitable isn't touched after publish call
+            void await_suspend(std::coroutine_handle<> handle) {
+                _publisher._publisher->publish(_msg, [this, handle](const DeliveryReport& report) {
+                    _report.emplace(report);
+                    _publisher._executor(handle);
+                });
+            }
+
+            DeliveryReport await_resume() {
+                return std::move(*_report);
+            }
+
+          private:
+            AsyncPublisher& _publisher;
+            const Message& _msg;
+            std::optional<DeliveryReport> _report;
+        };
+
+        AsyncPublisher(std::shared_ptr<Publisher> publisher, Executor executor) : _publisher(std::move(publisher)), _executor(std::move(executor)) {}
+
+        // Message must stay alive until awaitable is awaited, which holds for co_await publisher.publish_async(msg)
+        DeliveryAwaitable publish_async(const Message& msg) {
+            return DeliveryAwaitable(*this, msg);
+        }
+
+        const std::shared_ptr<Publisher>& publisher() const {
+            return _publisher;
+        }
+
+      private:
+        std::shared_ptr<Publisher> _publisher;
+        Executor _executor;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
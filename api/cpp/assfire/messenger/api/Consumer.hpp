@@ -3,9 +3,14 @@
 #include "Message.hpp"
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 namespace assfire::messenger {
+    using MessageHandler = std::function<void(const Message&)>;
+
     class Consumer {
       public:
         virtual ~Consumer()                                     = default;
@@ -16,5 +21,33 @@ namespace assfire::messenger {
         virtual void stop()                                     = 0;
         virtual void drain()                                    = 0;
         virtual void ack(const Message& msg)                    = 0;
+
+        // Polls next message into given one instead of returning a new message, releasing what it held before.
+        // Consumers reusing storage of released messages override it, so that steady polling allocates nothing
+        virtual void poll_into(Message& msg) {
+            msg = poll();
+        }
+        virtual void poll_into(Message& msg, std::chrono::milliseconds timeout) {
+            msg = poll(timeout);
+        }
+
+        virtual std::size_t poll_batch(std::vector<Message>& messages, std::size_t max_messages, std::chrono::milliseconds timeout) = 0;
+
+        // Invokes handler for every received message without blocking caller's thread, with at most concurrency handlers
+        // running at once. Message is acked when its handler returns. Subscribed consumer must not be polled
+        virtual void subscribe(MessageHandler handler, std::size_t concurrency) = 0;
+
+        // Non-blocking poll, returns 0 if there are no received messages
+        virtual std::size_t try_poll_batch(std::vector<Message>& messages, std::size_t max_messages) = 0;
+
+        // One-shot callback invoked once there are messages to poll or consumer is stopped, immediately if either is true already.
+        // It may be called from consumer's internal thread, so it shouldn't block. Returns id to cancel the callback with
+        virtual std::uint64_t notify_when_readable(std::function<void()> callback) = 0;
+
+        // Removes callback which wasn't invoked yet. Returns false if it was already invoked or is being invoked
+        virtual bool cancel_readable_notification(std::uint64_t id) = 0;
+
+        // True once stop was called. Messages received before stop may still be polled
+        virtual bool stopped() const = 0;
     };
 } // namespace assfire::messenger
\ No newline at end of file
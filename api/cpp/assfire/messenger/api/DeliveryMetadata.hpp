@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace assfire::messenger {
+    // Typed position of received message in its source stream. Topic name is shared between all messages
+    // received by the same consumer, so attaching metadata to message costs no allocation.
+    // Receive time is local to consuming process and isn't part of message identity
+    class DeliveryMetadata {
+      public:
+        using Timestamp  = std::chrono::system_clock::time_point;
+        using ReceivedAt = std::chrono::steady_clock::time_point;
+
+        DeliveryMetadata() = default;
+        DeliveryMetadata(std::shared_ptr<const std::string> topic, std::int32_t partition, std::int64_t offset,
+                         std::optional<Timestamp> timestamp = std::nullopt, std::optional<ReceivedAt> received_at = std::nullopt)
+            : _topic(std::move(topic)),
+              _partition(partition),
+              _offset(offset),
+              _timestamp(timestamp),
+              _received_at(received_at) {}
+        DeliveryMetadata(const DeliveryMetadata& rhs) = default;
+        DeliveryMetadata(DeliveryMetadata&& rhs)      = default;
+
+        DeliveryMetadata& operator=(const DeliveryMetadata& rhs) = default;
+        DeliveryMetadata& operator=(DeliveryMetadata&& rhs) = default;
+
+        bool operator==(const DeliveryMetadata& rhs) const {
+            return topic() == rhs.topic() && _partition == rhs._partition && _offset == rhs._offset && _timestamp == rhs._timestamp;
+        }
+
+        const std::string& topic() const {
+            static const std::string empty_topic;
+            return _topic ? *_topic : empty_topic;
+        }
+
+        const std::shared_ptr<const std::string>& topic_handle() const {
+            return _topic;
+        }
+
+        std::int32_t partition() const {
+            return _partition;
+        }
+
+        std::int64_t offset() const {
+            return _offset;
+        }
+
+        const std::optional<Timestamp>& timestamp() const {
+            return _timestamp;
+        }
+
+        // When message was received from broker and queued for polling
+        const std::optional<ReceivedAt>& received_at() const {
+            return _received_at;
+        }
+
+        std::string to_string() const {
+            return topic() + "/" + std::to_string(_partition) + "@" + std::to_string(_offset);
+        }
+
+      private:
+        std::shared_ptr<const std::string> _topic;
+        std::int32_t _partition = 0;
+        std::int64_t _offset    = 0;
+        std::optional<Timestamp> _timestamp;
+        std::optional<ReceivedAt> _received_at;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
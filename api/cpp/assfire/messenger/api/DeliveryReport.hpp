@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace assfire::messenger {
+    class DeliveryReport {
+      public:
+        DeliveryReport() = default;
+        DeliveryReport(std::int32_t partition, std::optional<std::int64_t> offset) : _partition(partition), _offset(offset) {}
+        explicit DeliveryReport(std::string error) : _error(std::move(error)) {}
+        DeliveryReport(const DeliveryReport& rhs) = default;
+        DeliveryReport(DeliveryReport&& rhs)      = default;
+
+        DeliveryReport& operator=(const DeliveryReport& rhs) = default;
+        DeliveryReport& operator=(DeliveryReport&& rhs) = default;
+
+        bool operator==(const DeliveryReport& rhs) const = default;
+
+        bool ok() const {
+            return !_error;
+        }
+
+        std::optional<std::int32_t> partition() const {
+            return _partition;
+        }
+
+        std::optional<std::int64_t> offset() const {
+            return _offset;
+        }
+
+        const std::optional<std::string>& error() const {
+            return _error;
+        }
+
+      private:
+        std::optional<std::int32_t> _partition;
+        std::optional<std::int64_t> _offset;
+        std::optional<std::string> _error;
+    };
+
+    using DeliveryCallback = std::function<void(const DeliveryReport&)>;
+} // namespace assfire::messenger
\ No newline at end of file
@@ -46,4 +46,15 @@ namespace assfire::messenger {
         PublisherConstructionError(const std::string& what) : PublisherError(what) {};
     };
 
+    class ChannelNotDeclaredError : public std::runtime_error {
+      public:
+        ChannelNotDeclaredError(const ChannelId& channel_id) : std::runtime_error(std::string("Channel not declared: ") + channel_id.name()) {}
+    };
+
+    class ChannelRedeclarationAttemptError : public std::runtime_error {
+      public:
+        ChannelRedeclarationAttemptError(const ChannelId& channel_id)
+            : std::runtime_error(std::string("Channel redeclaration with different settings: ") + channel_id.name()) {}
+    };
+
 } // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+
+namespace assfire::messenger {
+    // Resumes coroutine suspended on AsyncConsumer or AsyncPublisher awaitable, i.e. by posting it to an event loop or thread pool.
+    // It is called from messenger threads, so it shouldn't block
+    using Executor = std::function<void(std::coroutine_handle<>)>;
+
+    // Resumes coroutine right on the thread which completed the operation
+    inline Executor inline_executor() {
+        return [](std::coroutine_handle<> handle) { handle.resume(); };
+    }
+} // namespace assfire::messenger
\ No newline at end of file
@@ -1,15 +1,20 @@
 #pragma once
 
+#include "HeaderId.hpp"
+
 #include <string>
+#include <string_view>
 
 namespace assfire::messenger {
     class Header {
       public:
-        using Id    = std::string;
+        using Id    = HeaderId;
         using Value = std::string;
 
         Header() = default;
-        Header(const Id& id, const Value& value) : _id(id), _value(value) {}
+        Header(Id id, Value value) : _id(std::move(id)), _value(std::move(value)) {}
+        // Name is not interned, so headers decoded from received messages don't take registry lock
+        Header(std::string_view id, Value value) : _id(HeaderId::transient(id)), _value(std::move(value)) {}
         Header(const Header& rhs) = default;
         Header(Header&& rhs)      = default;
 
@@ -27,7 +32,7 @@ namespace assfire::messenger {
         }
 
         std::string to_string() const {
-            return _id + "=" + _value;
+            return _id.name() + "=" + _value;
         }
 
       private:
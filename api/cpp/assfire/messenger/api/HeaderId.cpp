@@ -0,0 +1,47 @@
+#include "HeaderId.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace assfire::messenger {
+    namespace {
+        struct NameHash {
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view name) const {
+                return std::hash<std::string_view> {}(name);
+            }
+        };
+
+        class HeaderIdRegistry {
+          public:
+            const std::string* intern(std::string_view name) {
+                {
+                    std::shared_lock<std::shared_mutex> lck(_mtx);
+                    auto iter = _names.find(name);
+                    if (iter != _names.end()) { return &*iter; }
+                }
+                std::unique_lock<std::shared_mutex> lck(_mtx);
+                return &*_names.emplace(name).first;
+            }
+
+          private:
+            std::shared_mutex _mtx;
+            std::unordered_set<std::string, NameHash, std::equal_to<>> _names;
+        };
+
+        HeaderIdRegistry& registry() {
+            static HeaderIdRegistry instance;
+            return instance;
+        }
+    } // namespace
+
+    HeaderId::HeaderId(std::string_view name) : _interned(registry().intern(name)) {}
+
+    HeaderId HeaderId::transient(std::string_view name) {
+        HeaderId result;
+        result._name = name;
+        return result;
+    }
+} // namespace assfire::messenger
\ No newline at end of file
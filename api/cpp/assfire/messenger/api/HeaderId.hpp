@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace assfire::messenger {
+    // Header name. Names declared by code are interned once for the whole process and compared by address.
+    // Names of received headers may be arbitrary, so they are kept by value and never grow the registry
+    class HeaderId {
+      public:
+        HeaderId() = default;
+        explicit HeaderId(std::string_view name);
+        HeaderId(const HeaderId& rhs) = default;
+        HeaderId(HeaderId&& rhs)      = default;
+
+        HeaderId& operator=(const HeaderId& rhs) = default;
+        HeaderId& operator=(HeaderId&& rhs) = default;
+
+        // Id which is not interned, lookups by it compare names
+        static HeaderId transient(std::string_view name);
+
+        bool operator==(const HeaderId& rhs) const {
+            if (_interned && rhs._interned) { return _interned == rhs._interned; }
+            return name() == rhs.name();
+        }
+
+        const std::string& name() const {
+            return _interned ? *_interned : _name;
+        }
+
+        bool interned() const {
+            return _interned != nullptr;
+        }
+
+      private:
+        const std::string* _interned = nullptr;
+        std::string _name;
+    };
+} // namespace assfire::messenger
+
+template<>
+struct std::hash<assfire::messenger::HeaderId> {
+    std::size_t operator()(const assfire::messenger::HeaderId& id) const {
+        return std::hash<std::string> {}(id.name());
+    }
+};
\ No newline at end of file
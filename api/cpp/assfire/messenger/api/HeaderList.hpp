@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Header.hpp"
+
+#include <absl/container/inlined_vector.h>
+#include <cstddef>
+#include <string_view>
+
+namespace assfire::messenger {
+    // Flat header storage for the few headers message usually carries. Headers are kept inline
+    // without per-header nodes, lookups are linear scans comparing ids by address when both are interned
+    class HeaderList {
+      public:
+        static constexpr std::size_t INLINE_CAPACITY = 4;
+
+        using Storage        = absl::InlinedVector<Header, INLINE_CAPACITY>;
+        using const_iterator = Storage::const_iterator;
+
+        HeaderList() = default;
+        HeaderList(std::initializer_list<Header> headers) {
+            for (const auto& h : headers) {
+                add(h);
+            }
+        }
+        HeaderList(const HeaderList& rhs) = default;
+        HeaderList(HeaderList&& rhs)      = default;
+
+        HeaderList& operator=(const HeaderList& rhs) = default;
+        HeaderList& operator=(HeaderList&& rhs) = default;
+
+        bool operator==(const HeaderList& rhs) const = default;
+
+        // Header is not replaced if one with the same id is already present
+        bool add(Header header) {
+            if (find(header.id())) { return false; }
+            _headers.push_back(std::move(header));
+            return true;
+        }
+
+        const Header* find(const Header::Id& id) const {
+            for (const auto& h : _headers) {
+                if (h.id() == id) { return &h; }
+            }
+            return nullptr;
+        }
+
+        const Header* find(std::string_view id) const {
+            for (const auto& h : _headers) {
+                if (h.id().name() == id) { return &h; }
+            }
+            return nullptr;
+        }
+
+        std::size_t size() const {
+            return _headers.size();
+        }
+
+        bool empty() const {
+            return _headers.empty();
+        }
+
+        const_iterator begin() const {
+            return _headers.begin();
+        }
+
+        const_iterator end() const {
+            return _headers.end();
+        }
+
+      private:
+        Storage _headers;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -1,25 +1,31 @@
 #pragma once
 
+#include "DeliveryMetadata.hpp"
 #include "Header.hpp"
+#include "HeaderList.hpp"
 #include "Payload.hpp"
+#include "PayloadBuffer.hpp"
+#include "RecordHeaders.hpp"
 
 #include <absl/strings/str_join.h>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 namespace assfire::messenger {
     class Message {
       public:
-        using Headers = std::unordered_map<Header::Id, Header>;
+        using Headers = HeaderList;
 
         Message() = default;
-        Message(Headers headers, Payload payload) : _headers(std::move(headers)), _payload(std::move(payload)) {}
-        explicit Message(Payload payload) : _payload(std::move(payload)) {}
+        Message(Headers headers, PayloadBuffer payload) : _headers(std::move(headers)), _payload(std::move(payload)) {}
+        explicit Message(PayloadBuffer payload) : _payload(std::move(payload)) {}
         template<ProtoMessage T>
-        explicit Message(const T msg) : _payload(pack(msg)) {};
+        explicit Message(const T& msg) : _payload(pack(msg)) {};
         Message(const Message& rhs) = default;
         Message(Message&& rhs)      = default;
 
@@ -29,41 +35,92 @@ namespace assfire::messenger {
         bool operator==(const Message& rhs) const = default;
 
         void add_header(Header header) {
-            _headers.emplace(header.id(), std::move(header));
+            _headers.add(std::move(header));
         }
 
-        void set_payload(Payload payload) {
+        // Messages with equal keys are published to the same partition, so their relative order is preserved
+        void set_key(std::string key) {
+            _key = std::move(key);
+        }
+
+        void set_payload(PayloadBuffer payload) {
             _payload = std::move(payload);
         }
 
+        void set_record_headers(std::shared_ptr<const RecordHeaders> record_headers) {
+            _record_headers = std::move(record_headers);
+        }
+
+        void set_delivery_metadata(DeliveryMetadata delivery_metadata) {
+            _delivery_metadata = std::move(delivery_metadata);
+        }
+
         std::optional<std::string> header(const Header::Id& id) const {
-            auto iter = _headers.find(id);
-            if (iter == _headers.end()) {
+            const Header* h = _headers.find(id);
+            if (h) { return h->value(); }
+            if (_record_headers) {
+                if (auto value = _record_headers->find(id.name())) { return std::string(*value); }
+            }
+            return std::nullopt;
+        }
+
+        std::optional<std::string> header(std::string_view id) const {
+            auto value = header_view(id);
+            if (!value) {
                 return std::nullopt;
             } else {
-                return iter->second.value();
+                return std::string(*value);
             }
         }
 
+        // Looks up own headers first and then headers received with the message, without copying the value
+        std::optional<std::string_view> header_view(std::string_view id) const {
+            const Header* h = _headers.find(id);
+            if (h) { return h->value(); }
+            if (_record_headers) { return _record_headers->find(id); }
+            return std::nullopt;
+        }
+
         const Headers& headers() const {
             return _headers;
         }
 
-        const Payload& payload() const {
+        const std::shared_ptr<const RecordHeaders>& record_headers() const {
+            return _record_headers;
+        }
+
+        const std::optional<std::string>& key() const {
+            return _key;
+        }
+
+        const PayloadBuffer& payload() const {
             return _payload;
         }
 
+        // Set only for messages received from consumer
+        const std::optional<DeliveryMetadata>& delivery_metadata() const {
+            return _delivery_metadata;
+        }
+
         std::string headers_to_string() const {
             std::vector<std::string> headers;
             headers.reserve(_headers.size());
             for (const auto& h : _headers) {
-                headers.push_back(h.second.to_string());
+                headers.push_back(h.to_string());
+            }
+            if (_record_headers) {
+                for (const auto& h : _record_headers->to_headers()) {
+                    headers.push_back(h.to_string());
+                }
             }
             return "{" + absl::StrJoin(headers, ",") + "}";
         }
 
       private:
-        std::unordered_map<Header::Id, Header> _headers;
-        Payload _payload;
+        Headers _headers;
+        std::optional<std::string> _key;
+        PayloadBuffer _payload;
+        std::shared_ptr<const RecordHeaders> _record_headers;
+        std::optional<DeliveryMetadata> _delivery_metadata;
     };
 } // namespace assfire::messenger
\ No newline at end of file
@@ -13,5 +13,9 @@ namespace assfire::messenger {
 
         virtual std::shared_ptr<Publisher> get_publisher(const ChannelId& channel_id) = 0;
         virtual std::shared_ptr<Consumer> get_consumer(const ChannelId& channel_id)   = 0;
+
+        void subscribe(const ChannelId& channel_id, MessageHandler handler, std::size_t concurrency = 1) {
+            get_consumer(channel_id)->subscribe(std::move(handler), concurrency);
+        }
     };
 } // namespace assfire::messenger
\ No newline at end of file
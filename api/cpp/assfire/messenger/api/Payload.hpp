@@ -2,6 +2,7 @@
 
 #include <concepts>
 #include <cstdint>
+#include <span>
 #include <string>
 
 namespace assfire::messenger {
@@ -19,6 +20,13 @@ namespace assfire::messenger {
         ->std::convertible_to<bool>;
     };
 
+    // Satisfied by google::protobuf::Arena, so arena-backed unpack doesn't tie the api to protobuf
+    template<typename A, typename T>
+    concept ProtoArena = requires(A &arena) {
+        { A::template CreateMessage<T>(&arena) }
+        ->std::same_as<T *>;
+    };
+
     Payload pack(const std::string &msg);
 
     template<ProtoMessage T>
@@ -30,12 +38,31 @@ namespace assfire::messenger {
     };
 
     template<ProtoMessage T>
-    T unpack(const Payload p) {
+    T unpack(std::span<const uint8_t> p) {
         T result;
         result.ParseFromArray(p.data(), p.size());
         return result;
     };
 
+    template<ProtoMessage T>
+    T unpack(const Payload &p) {
+        return unpack<T>(std::span<const uint8_t>(p.data(), p.size()));
+    };
+
+    // Parses message into arena, so the message and its nested messages, strings and repeated fields are allocated from arena
+    // blocks and freed all at once when arena is reset or destroyed. Returned message is owned by arena and must not be deleted
+    template<ProtoMessage T, ProtoArena<T> A>
+    T *unpack(std::span<const uint8_t> p, A &arena) {
+        T *result = A::template CreateMessage<T>(&arena);
+        result->ParseFromArray(p.data(), p.size());
+        return result;
+    };
+
+    template<ProtoMessage T, ProtoArena<T> A>
+    T *unpack(const Payload &p, A &arena) {
+        return unpack<T>(std::span<const uint8_t>(p.data(), p.size()), arena);
+    };
+
     std::string_view to_string_view(const Payload& payload);
 
 } // namespace assfire::messenger
\ No newline at end of file
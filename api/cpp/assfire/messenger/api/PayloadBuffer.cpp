@@ -0,0 +1,14 @@
+#include "PayloadBuffer.hpp"
+
+namespace assfire::messenger {
+    PayloadBuffer::PayloadBuffer(Payload payload) {
+        auto owner = std::make_shared<const Payload>(std::move(payload));
+        _data      = owner->data();
+        _size      = owner->size();
+        _owner     = std::move(owner);
+    }
+
+    std::string_view to_string_view(const PayloadBuffer &payload) {
+        return std::string_view((std::string::value_type *) payload.data(), payload.size());
+    }
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Payload.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+namespace assfire::messenger {
+    // Immutable view over payload bytes sharing ownership of the underlying storage.
+    // Copies and slices only bump the reference count of the owner, so payloads received from
+    // transport (e.g. librdkafka message) are handed to application without copying the bytes
+    class PayloadBuffer {
+      public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        PayloadBuffer() = default;
+        PayloadBuffer(Payload payload);
+        PayloadBuffer(std::shared_ptr<const void> owner, const uint8_t *data, std::size_t size)
+            : _owner(std::move(owner)),
+              _data(data),
+              _size(size) {}
+        PayloadBuffer(const PayloadBuffer &rhs) = default;
+        PayloadBuffer(PayloadBuffer &&rhs)      = default;
+
+        PayloadBuffer &operator=(const PayloadBuffer &rhs) = default;
+        PayloadBuffer &operator=(PayloadBuffer &&rhs) = default;
+
+        bool operator==(const PayloadBuffer &rhs) const {
+            return std::ranges::equal(span(), rhs.span());
+        }
+
+        const uint8_t *data() const {
+            return _data;
+        }
+
+        std::size_t size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        const uint8_t *begin() const {
+            return _data;
+        }
+
+        const uint8_t *end() const {
+            return _data + _size;
+        }
+
+        std::span<const uint8_t> span() const {
+            return std::span<const uint8_t>(_data, _size);
+        }
+
+        const std::shared_ptr<const void> &owner() const {
+            return _owner;
+        }
+
+        PayloadBuffer slice(std::size_t offset, std::size_t length = npos) const {
+            if (offset > _size) { throw std::out_of_range("Payload slice offset is out of range"); }
+            return PayloadBuffer(_owner, _data + offset, std::min(length, _size - offset));
+        }
+
+        Payload to_payload() const {
+            return Payload(_data, _size);
+        }
+
+      private:
+        std::shared_ptr<const void> _owner;
+        const uint8_t *_data = nullptr;
+        std::size_t _size    = 0;
+    };
+
+    template<ProtoMessage T>
+    T unpack(const PayloadBuffer &p) {
+        return unpack<T>(p.span());
+    };
+
+    template<ProtoMessage T, ProtoArena<T> A>
+    T *unpack(const PayloadBuffer &p, A &arena) {
+        return unpack<T>(p.span(), arena);
+    };
+
+    std::string_view to_string_view(const PayloadBuffer &payload);
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace assfire::messenger {
+    class PublishFailure {
+      public:
+        PublishFailure(std::size_t index, std::string error) : _index(index), _error(std::move(error)) {}
+        PublishFailure(const PublishFailure& rhs) = default;
+        PublishFailure(PublishFailure&& rhs)      = default;
+
+        PublishFailure& operator=(const PublishFailure& rhs) = default;
+        PublishFailure& operator=(PublishFailure&& rhs) = default;
+
+        bool operator==(const PublishFailure& rhs) const = default;
+
+        std::size_t index() const {
+            return _index;
+        }
+
+        const std::string& error() const {
+            return _error;
+        }
+
+      private:
+        std::size_t _index;
+        std::string _error;
+    };
+
+    class PublishBatchResult {
+      public:
+        PublishBatchResult() = default;
+        PublishBatchResult(std::size_t total, std::vector<PublishFailure> failures) : _total(total), _failures(std::move(failures)) {}
+        PublishBatchResult(const PublishBatchResult& rhs) = default;
+        PublishBatchResult(PublishBatchResult&& rhs)      = default;
+
+        PublishBatchResult& operator=(const PublishBatchResult& rhs) = default;
+        PublishBatchResult& operator=(PublishBatchResult&& rhs) = default;
+
+        bool ok() const {
+            return _failures.empty();
+        }
+
+        std::size_t total() const {
+            return _total;
+        }
+
+        std::size_t published() const {
+            return _total - _failures.size();
+        }
+
+        // Failed messages ordered by their index in the published batch
+        const std::vector<PublishFailure>& failures() const {
+            return _failures;
+        }
+
+      private:
+        std::size_t _total = 0;
+        std::vector<PublishFailure> _failures;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
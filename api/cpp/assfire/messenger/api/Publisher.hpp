@@ -1,11 +1,52 @@
 #pragma once
 
+#include "DeliveryReport.hpp"
+#include "Exceptions.hpp"
 #include "Message.hpp"
+#include "Payload.hpp"
+#include "PublishBatchResult.hpp"
+
+#include <absl/functional/function_ref.h>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <span>
 
 namespace assfire::messenger {
     class Publisher {
       public:
         virtual ~Publisher()                     = default;
         virtual void publish(const Message& msg) = 0;
+
+        // Callback is invoked exactly once when message is either delivered or failed
+        virtual void publish(const Message& msg, DeliveryCallback callback) = 0;
+
+        // Blocks until every message of the batch is either delivered or failed
+        virtual PublishBatchResult publish_batch(std::span<const Message> messages) = 0;
+
+        // Publishes payload of given size which serialize writes into a buffer handed over to the transport as is.
+        // Publishers which own their send buffers override it to avoid copying the payload once more
+        virtual void publish_serialized(std::size_t size, absl::FunctionRef<void(std::uint8_t*, std::size_t)> serialize) {
+            std::shared_ptr<std::uint8_t[]> buffer = std::make_shared_for_overwrite<std::uint8_t[]>(size);
+            serialize(buffer.get(), size);
+            publish(Message(PayloadBuffer(buffer, buffer.get(), size)));
+        }
+
+        // Serializes protobuf straight into publisher's buffer, computing its size once and skipping intermediate message and payload.
+        // Derived publishers bring it into scope with using Publisher::publish
+        template<ProtoMessage T>
+        void publish(const T& proto) {
+            publish_serialized(proto.ByteSizeLong(), [&proto](std::uint8_t* data, std::size_t size) {
+                if (!proto.SerializeToArray(data, static_cast<int>(size))) { throw PublisherError("Failed to serialize message"); }
+            });
+        }
+
+        std::future<DeliveryReport> publish_async(const Message& msg) {
+            auto promise                       = std::make_shared<std::promise<DeliveryReport>>();
+            std::future<DeliveryReport> result = promise->get_future();
+            publish(msg, [promise](const DeliveryReport& report) { promise->set_value(report); });
+            return result;
+        }
     };
 } // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Header.hpp"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace assfire::messenger {
+    // Headers which arrived together with received message and are still owned by transport.
+    // Lookups return views into transport buffers instead of copies
+    class RecordHeaders {
+      public:
+        virtual ~RecordHeaders() = default;
+
+        virtual std::optional<std::string_view> find(std::string_view id) const = 0;
+        virtual std::vector<Header> to_headers() const                          = 0;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
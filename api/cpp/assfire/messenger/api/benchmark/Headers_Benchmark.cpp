@@ -0,0 +1,129 @@
+#include "assfire/messenger/api/Message.hpp"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+
+using namespace assfire::messenger;
+
+namespace {
+    std::atomic<std::size_t> allocations_count {0};
+
+    // Header storage used by Message before flat header list was introduced, kept as a baseline
+    class LegacyHeader {
+      public:
+        LegacyHeader(const std::string& id, const std::string& value) : _id(id), _value(value) {}
+
+        const std::string& id() const {
+            return _id;
+        }
+
+        const std::string& value() const {
+            return _value;
+        }
+
+      private:
+        std::string _id;
+        std::string _value;
+    };
+
+    using LegacyHeaders = std::unordered_map<std::string, LegacyHeader>;
+
+    void set_allocations_counter(benchmark::State& state, std::size_t allocations_before) {
+        state.counters["allocs_per_message"] =
+            benchmark::Counter(static_cast<double>(allocations_count.load() - allocations_before), benchmark::Counter::kAvgIterations);
+    }
+} // namespace
+
+// Counts every allocation of the binary, so headers benchmarks are built separately from the other api benchmarks
+void* operator new(std::size_t size) {
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+static void Headers_LegacyMapConstruction(benchmark::State& state) {
+    std::size_t allocations_before = allocations_count.load();
+    for (auto _ : state) {
+        LegacyHeaders headers;
+        LegacyHeader tenant("tenant", "tenant-1");
+        headers.emplace(tenant.id(), tenant);
+        LegacyHeader trace_id("trace-id", "0af7651916cd43dd");
+        headers.emplace(trace_id.id(), trace_id);
+        LegacyHeader content_type("content-type", "proto");
+        headers.emplace(content_type.id(), content_type);
+        benchmark::DoNotOptimize(headers);
+    }
+    set_allocations_counter(state, allocations_before);
+}
+BENCHMARK(Headers_LegacyMapConstruction);
+
+static void Headers_MessageConstruction(benchmark::State& state) {
+    static const HeaderId tenant("tenant");
+    static const HeaderId trace_id("trace-id");
+    static const HeaderId content_type("content-type");
+
+    std::size_t allocations_before = allocations_count.load();
+    for (auto _ : state) {
+        Message msg;
+        msg.add_header(Header(tenant, "tenant-1"));
+        msg.add_header(Header(trace_id, "0af7651916cd43dd"));
+        msg.add_header(Header(content_type, "proto"));
+        benchmark::DoNotOptimize(msg);
+    }
+    set_allocations_counter(state, allocations_before);
+}
+BENCHMARK(Headers_MessageConstruction);
+
+static void Headers_LegacyMapLookup(benchmark::State& state) {
+    LegacyHeaders headers;
+    headers.emplace("tenant", LegacyHeader("tenant", "tenant-1"));
+    headers.emplace("trace-id", LegacyHeader("trace-id", "0af7651916cd43dd"));
+    headers.emplace("content-type", LegacyHeader("content-type", "proto"));
+    const std::string id = "content-type";
+
+    for (auto _ : state) {
+        auto iter = headers.find(id);
+        benchmark::DoNotOptimize(iter);
+    }
+}
+BENCHMARK(Headers_LegacyMapLookup);
+
+static void Headers_MessageLookupByName(benchmark::State& state) {
+    Message msg;
+    msg.add_header(Header("tenant", "tenant-1"));
+    msg.add_header(Header("trace-id", "0af7651916cd43dd"));
+    msg.add_header(Header("content-type", "proto"));
+    const std::string id = "content-type";
+
+    for (auto _ : state) {
+        const Header* h = msg.headers().find(id);
+        benchmark::DoNotOptimize(h);
+    }
+}
+BENCHMARK(Headers_MessageLookupByName);
+
+static void Headers_MessageLookupById(benchmark::State& state) {
+    Message msg;
+    msg.add_header(Header("tenant", "tenant-1"));
+    msg.add_header(Header("trace-id", "0af7651916cd43dd"));
+    msg.add_header(Header("content-type", "proto"));
+    const HeaderId id("content-type");
+
+    for (auto _ : state) {
+        const Header* h = msg.headers().find(id);
+        benchmark::DoNotOptimize(h);
+    }
+}
+BENCHMARK(Headers_MessageLookupById);
\ No newline at end of file
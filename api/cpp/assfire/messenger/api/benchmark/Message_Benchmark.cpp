@@ -0,0 +1,53 @@
+#include "assfire/messenger/api/Message.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+using namespace assfire::messenger;
+
+namespace {
+    Message make_message(std::size_t payload_size) {
+        Message msg(pack(std::string(payload_size, 'x')));
+        msg.set_key("entity-1");
+        msg.add_header(Header("tenant", "tenant-1"));
+        msg.add_header(Header("trace-id", "0af7651916cd43dd"));
+        return msg;
+    }
+} // namespace
+
+static void Message_ConstructionFromPayload(benchmark::State& state) {
+    Payload payload = pack(std::string(state.range(0), 'x'));
+    for (auto _ : state) {
+        Message msg {PayloadBuffer(Payload(payload))};
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Message_ConstructionFromPayload)->Arg(64)->Arg(1024)->Arg(64 * 1024);
+
+static void Message_ConstructionWithHeaders(benchmark::State& state) {
+    for (auto _ : state) {
+        Message msg = make_message(state.range(0));
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(Message_ConstructionWithHeaders)->Arg(64)->Arg(1024);
+
+// Payload buffer is shared between copies, so copy cost shouldn't depend on payload size
+static void Message_Copy(benchmark::State& state) {
+    Message msg = make_message(state.range(0));
+    for (auto _ : state) {
+        Message copy(msg);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(Message_Copy)->Arg(64)->Arg(64 * 1024);
+
+static void Message_HeaderLookup(benchmark::State& state) {
+    Message msg = make_message(64);
+    HeaderId trace_id("trace-id");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(msg.header_view(trace_id.name()));
+    }
+}
+BENCHMARK(Message_HeaderLookup);
\ No newline at end of file
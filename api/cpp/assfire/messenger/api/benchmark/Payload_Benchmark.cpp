@@ -0,0 +1,103 @@
+#include "assfire/messenger/api/Payload.hpp"
+#include "assfire/messenger/api/PayloadBuffer.hpp"
+#include "assfire/messenger/api/benchmark/BenchmarkMessage.pb.h"
+
+#include <benchmark/benchmark.h>
+#include <google/protobuf/arena.h>
+#include <string>
+
+using namespace assfire::messenger;
+using assfire::messenger::benchmarks::BenchmarkMessage;
+
+namespace {
+    BenchmarkMessage make_proto(std::size_t coordinates_count) {
+        BenchmarkMessage msg;
+        msg.set_id("order-42");
+        msg.set_created_at(1666000000000);
+        for (std::size_t i = 0; i < coordinates_count; ++i) {
+            msg.add_coordinates(static_cast<double>(i) * 0.5);
+        }
+        msg.set_description("Delivery of a parcel to the customer");
+        return msg;
+    }
+
+    BenchmarkMessage make_route(std::size_t stops_count) {
+        BenchmarkMessage msg = make_proto(0);
+        for (std::size_t i = 0; i < stops_count; ++i) {
+            auto* stop = msg.add_stops();
+            stop->set_address("Customer street, building " + std::to_string(i));
+            stop->set_latitude(55.75 + static_cast<double>(i) * 0.001);
+            stop->set_longitude(37.61 + static_cast<double>(i) * 0.001);
+            stop->add_parcels("parcel-" + std::to_string(i) + "-a-with-a-longer-tracking-number");
+            stop->add_parcels("parcel-" + std::to_string(i) + "-b-with-a-longer-tracking-number");
+        }
+        return msg;
+    }
+
+    // Messages polled at once are unpacked into one arena, which is reset after the batch is handled
+    constexpr std::size_t ARENA_BATCH_SIZE = 64;
+} // namespace
+
+static void Payload_PackString(benchmark::State& state) {
+    std::string value(state.range(0), 'x');
+    for (auto _ : state) {
+        Payload payload = pack(value);
+        benchmark::DoNotOptimize(payload);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Payload_PackString)->Arg(64)->Arg(1024)->Arg(64 * 1024);
+
+static void Payload_UnpackString(benchmark::State& state) {
+    PayloadBuffer payload(pack(std::string(state.range(0), 'x')));
+    for (auto _ : state) {
+        std::string value(to_string_view(payload));
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Payload_UnpackString)->Arg(64)->Arg(1024)->Arg(64 * 1024);
+
+static void Payload_PackProto(benchmark::State& state) {
+    BenchmarkMessage msg = make_proto(state.range(0));
+    for (auto _ : state) {
+        Payload payload = pack(msg);
+        benchmark::DoNotOptimize(payload);
+    }
+    state.SetBytesProcessed(state.iterations() * msg.ByteSizeLong());
+}
+BENCHMARK(Payload_PackProto)->Arg(4)->Arg(1024);
+
+static void Payload_UnpackProto(benchmark::State& state) {
+    BenchmarkMessage msg = make_proto(state.range(0));
+    PayloadBuffer payload(pack(msg));
+    for (auto _ : state) {
+        BenchmarkMessage result = unpack<BenchmarkMessage>(payload);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(Payload_UnpackProto)->Arg(4)->Arg(1024);
+
+static void Payload_UnpackNestedProto(benchmark::State& state) {
+    PayloadBuffer payload(pack(make_route(state.range(0))));
+    for (auto _ : state) {
+        BenchmarkMessage result = unpack<BenchmarkMessage>(payload);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(Payload_UnpackNestedProto)->Arg(16)->Arg(256);
+
+static void Payload_UnpackNestedProtoIntoArena(benchmark::State& state) {
+    PayloadBuffer payload(pack(make_route(state.range(0))));
+    google::protobuf::Arena arena;
+    std::size_t unpacked = 0;
+    for (auto _ : state) {
+        BenchmarkMessage* result = unpack<BenchmarkMessage>(payload, arena);
+        benchmark::DoNotOptimize(result);
+        if (++unpacked % ARENA_BATCH_SIZE == 0) { arena.Reset(); }
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(Payload_UnpackNestedProtoIntoArena)->Arg(16)->Arg(256);
\ No newline at end of file
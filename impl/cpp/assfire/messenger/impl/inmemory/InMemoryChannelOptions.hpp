@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace assfire::messenger {
+    class InMemoryChannelOptions {
+      public:
+        InMemoryChannelOptions()                                  = default;
+        InMemoryChannelOptions(const InMemoryChannelOptions &rhs) = default;
+        InMemoryChannelOptions(InMemoryChannelOptions &&rhs)      = default;
+
+        InMemoryChannelOptions &operator=(const InMemoryChannelOptions &rhs) = default;
+        InMemoryChannelOptions &operator=(InMemoryChannelOptions &&rhs) = default;
+
+        bool operator==(const InMemoryChannelOptions &rhs) const = default;
+
+        std::string to_string() const {
+            return "{capacity = " + std::to_string(_capacity) + ",single_producer = " + (_single_producer ? "true" : "false") +
+                   ",single_consumer = " + (_single_consumer ? "true" : "false") + "}";
+        }
+
+        // Maximum number of published messages which weren't polled yet, rounded up to a power of two.
+        // Publishers block while channel is full
+        std::size_t capacity() const {
+            return _capacity;
+        }
+        void set_capacity(std::size_t capacity) {
+            _capacity = capacity;
+        }
+
+        // When both single producer and single consumer are promised, channel switches to a cheaper SPSC ring.
+        // It is then up to the caller to publish from one thread at a time and to poll from one thread at a time
+        bool single_producer() const {
+            return _single_producer;
+        }
+        void set_single_producer(bool single_producer) {
+            _single_producer = single_producer;
+        }
+
+        bool single_consumer() const {
+            return _single_consumer;
+        }
+        void set_single_consumer(bool single_consumer) {
+            _single_consumer = single_consumer;
+        }
+
+      private:
+        std::size_t _capacity = 1024;
+        bool _single_producer = false;
+        bool _single_consumer = false;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
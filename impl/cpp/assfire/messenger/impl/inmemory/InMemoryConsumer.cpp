@@ -0,0 +1,273 @@
+#include "InMemoryConsumer.hpp"
+
+#include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+#include "assfire/messenger/impl/util/ScopedThreadRole.hpp"
+
+#include <algorithm>
+
+namespace assfire::messenger {
+
+    namespace {
+        // Handler task yields arena thread to other channels after handling this many messages
+        constexpr std::size_t HANDLER_TASK_BATCH = 64;
+        // Blocked publishers and drain recheck channel state at least this often
+        constexpr std::chrono::milliseconds SPACE_WAIT_TIMEOUT = std::chrono::seconds(1);
+        // Handler calling stop() must not wait for its own task
+        constexpr int HANDLER_ROLE = 1;
+    } // namespace
+
+    InMemoryConsumer::InMemoryConsumer(ChannelId channel_id, InMemoryChannelOptions options, std::shared_ptr<tbb::task_arena> handlers_arena)
+        : _topic(std::make_shared<const std::string>(channel_id.name())),
+          _options(std::move(options)),
+          _interrupted(false),
+          _paused(false),
+          _acked_messages(0),
+          _has_readable_callbacks(false),
+          _handlers_arena(std::move(handlers_arena)),
+          _subscribed(false),
+          _running_handlers(0),
+          _logger(logger::LoggerProvider::get("assfire.messenger.InMemoryConsumer")) {
+        if (_options.single_producer() && _options.single_consumer()) {
+            _spsc_ring = std::make_unique<SpscRingBuffer<Message>>(_options.capacity());
+        } else {
+            _mpmc_ring = std::make_unique<MpmcRingBuffer<Message>>(_options.capacity());
+        }
+    }
+
+    InMemoryConsumer::~InMemoryConsumer() {
+        stop();
+    }
+
+    Message InMemoryConsumer::poll() {
+        while (true) {
+            try {
+                return poll(std::chrono::minutes(1));
+            } catch (const TimeoutError& e) {
+                // Just waiting for next loop
+            }
+        }
+    }
+
+    Message InMemoryConsumer::poll(std::chrono::milliseconds timeout) {
+        wait_for_new_messages(timeout);
+
+        Message msg;
+        if (!try_pop(msg)) { throw EndOfStreamError(); }
+        return msg;
+    }
+
+    std::size_t InMemoryConsumer::poll_batch(std::vector<Message>& messages, std::size_t max_messages, std::chrono::milliseconds timeout) {
+        if (max_messages == 0) { return 0; }
+        wait_for_new_messages(timeout);
+
+        std::size_t polled = try_poll_batch(messages, max_messages);
+        if (polled == 0) { throw EndOfStreamError(); }
+        return polled;
+    }
+
+    std::size_t InMemoryConsumer::try_poll_batch(std::vector<Message>& messages, std::size_t max_messages) {
+        std::size_t polled = 0;
+        Message msg;
+        while (polled < max_messages && try_pop(msg)) {
+            messages.push_back(std::move(msg));
+            ++polled;
+        }
+        return polled;
+    }
+
+    // Flag is raised before checking for messages and publishers check it after pushing, with full fences on both sides,
+    // so either this call sees the pushed message or the publisher sees the registered callback
+    std::uint64_t InMemoryConsumer::notify_when_readable(std::function<void()> callback) {
+        std::uint64_t id;
+        {
+            std::lock_guard<std::mutex> lck(_readable_mtx);
+            id = ++_next_readable_callback_id;
+            _has_readable_callbacks.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!is_readable() && !_interrupted) {
+                _readable_callbacks.emplace(id, std::move(callback));
+                return id;
+            }
+            _has_readable_callbacks.store(!_readable_callbacks.empty());
+        }
+        callback();
+        return id;
+    }
+
+    bool InMemoryConsumer::cancel_readable_notification(std::uint64_t id) {
+        std::lock_guard<std::mutex> lck(_readable_mtx);
+        bool cancelled = _readable_callbacks.erase(id) > 0;
+        _has_readable_callbacks.store(!_readable_callbacks.empty());
+        return cancelled;
+    }
+
+    bool InMemoryConsumer::stopped() const {
+        return _interrupted;
+    }
+
+    void InMemoryConsumer::ack(const Message& msg) {
+        const std::optional<DeliveryMetadata>& metadata = msg.delivery_metadata();
+        if (!metadata || metadata->topic() != *_topic) {
+            _logger->error("Failed to ack message with headers {}: message wasn't received from channel {}", msg.headers_to_string(), *_topic);
+            throw AckFailedError("Failed to ack message which wasn't received from channel " + *_topic);
+        }
+        _acked_messages.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void InMemoryConsumer::pause() {
+        _paused = true;
+    }
+
+    void InMemoryConsumer::resume() {
+        _paused = false;
+        _readable_notifier.notify_all();
+        notify_readable();
+        if (_subscribed.load(std::memory_order_acquire)) { schedule_handlers(); }
+    }
+
+    // Wakes blocked pollers, publishers and readable callbacks and waits for running handlers. Messages left in channel may still be polled.
+    // Called from a handler, it doesn't wait for the calling handler task
+    void InMemoryConsumer::stop() {
+        _interrupted = true;
+        _readable_notifier.notify_all();
+        _writable_notifier.notify_all();
+        notify_readable();
+
+        std::size_t own_tasks = ScopedThreadRole::current(this, HANDLER_ROLE) ? 1 : 0;
+        std::unique_lock<std::mutex> lck(_handlers_mtx);
+        _handlers_cv.wait(lck, [&] { return _handler_tasks == own_tasks; });
+    }
+
+    void InMemoryConsumer::drain() {
+        while (!_writable_notifier.wait_for([&] { return ring_empty() || _interrupted; }, SPACE_WAIT_TIMEOUT)) {}
+    }
+
+    void InMemoryConsumer::subscribe(MessageHandler handler, std::size_t concurrency) {
+        if (_subscribed) {
+            _logger->error("Failed to subscribe handler to channel {}: consumer is already subscribed", *_topic);
+            throw ConsumerError("Handler is already subscribed to channel " + *_topic);
+        }
+        if (_spsc_ring && concurrency > 1) {
+            _logger->error("Failed to subscribe handler to channel {}: single consumer channel can't run concurrent handlers", *_topic);
+            throw ConsumerError("Single consumer channel " + *_topic + " can't run concurrent handlers");
+        }
+
+        if (!_handlers_arena) { _handlers_arena = std::make_shared<tbb::task_arena>(); }
+        _handler             = std::move(handler);
+        _handler_concurrency = std::max<std::size_t>(concurrency, 1);
+        _subscribed.store(true, std::memory_order_release);
+        schedule_handlers();
+    }
+
+    std::uint64_t InMemoryConsumer::push(const Message& msg) {
+        std::uint64_t position = 0;
+        while (true) {
+            if (_interrupted) {
+                _logger->error("Failed to publish message to channel {}: channel is stopped", *_topic);
+                throw PublisherError("Channel " + *_topic + " is stopped");
+            }
+            if (try_push(msg, position)) { break; }
+            _writable_notifier.wait_for([&] { return !ring_full() || _interrupted; }, SPACE_WAIT_TIMEOUT);
+        }
+        on_pushed();
+        return position;
+    }
+
+    bool InMemoryConsumer::try_push(const Message& msg, std::uint64_t& position) {
+        return _spsc_ring ? _spsc_ring->try_push(msg, position) : _mpmc_ring->try_push(msg, position);
+    }
+
+    bool InMemoryConsumer::try_pop(Message& msg) {
+        if (_paused) { return false; }
+
+        std::uint64_t position = 0;
+        bool popped            = _spsc_ring ? _spsc_ring->try_pop(msg, position) : _mpmc_ring->try_pop(msg, position);
+        if (!popped) { return false; }
+
+        msg.set_delivery_metadata(DeliveryMetadata(_topic, 0, static_cast<std::int64_t>(position)));
+        _writable_notifier.notify_all();
+        return true;
+    }
+
+    bool InMemoryConsumer::ring_empty() const {
+        return _spsc_ring ? _spsc_ring->empty() : _mpmc_ring->empty();
+    }
+
+    bool InMemoryConsumer::ring_full() const {
+        return _spsc_ring ? _spsc_ring->size() >= _spsc_ring->capacity() : _mpmc_ring->size() >= _mpmc_ring->capacity();
+    }
+
+    bool InMemoryConsumer::is_readable() const {
+        return !_paused && !ring_empty();
+    }
+
+    void InMemoryConsumer::on_pushed() {
+        _readable_notifier.notify(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_has_readable_callbacks.load(std::memory_order_relaxed)) { notify_readable(); }
+        if (_subscribed.load(std::memory_order_acquire)) { schedule_handlers(); }
+    }
+
+    void InMemoryConsumer::wait_for_new_messages(std::chrono::milliseconds timeout) {
+        if (!_readable_notifier.wait_for([&] { return is_readable() || _interrupted; }, timeout)) { throw TimeoutError(); }
+    }
+
+    void InMemoryConsumer::notify_readable() {
+        std::map<std::uint64_t, std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lck(_readable_mtx);
+            if (_readable_callbacks.empty() || (!is_readable() && !_interrupted)) { return; }
+            callbacks.swap(_readable_callbacks);
+            _has_readable_callbacks.store(false);
+        }
+        for (auto& [id, callback] : callbacks) {
+            callback();
+        }
+    }
+
+    void InMemoryConsumer::schedule_handlers() {
+        while (!_interrupted && is_readable()) {
+            std::size_t running = _running_handlers.load();
+            if (running >= _handler_concurrency) { return; }
+            if (_running_handlers.compare_exchange_weak(running, running + 1)) {
+                {
+                    // Rechecked under lock so that stop() either waits for this task or prevents it from being enqueued
+                    std::lock_guard<std::mutex> lck(_handlers_mtx);
+                    if (_interrupted) {
+                        _running_handlers.fetch_sub(1);
+                        return;
+                    }
+                    ++_handler_tasks;
+                }
+                _handlers_arena->enqueue([this] { run_handlers(); });
+            }
+        }
+    }
+
+    void InMemoryConsumer::run_handlers() {
+        ScopedThreadRole role(this, HANDLER_ROLE);
+        Message msg;
+        for (std::size_t handled = 0; handled < HANDLER_TASK_BATCH && !_interrupted && try_pop(msg); ++handled) {
+            handle_message(msg);
+        }
+
+        // Messages that arrive after slot is released are seen either by this recheck or by their publisher
+        _running_handlers.fetch_sub(1);
+        schedule_handlers();
+
+        std::lock_guard<std::mutex> lck(_handlers_mtx);
+        --_handler_tasks;
+        _handlers_cv.notify_all();
+    }
+
+    void InMemoryConsumer::handle_message(const Message& msg) {
+        try {
+            _handler(msg);
+        } catch (const std::exception& e) {
+            _logger->error("Failed to handle message {}: {}", msg.delivery_metadata()->to_string(), e.what());
+        }
+        ack(msg);
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "InMemoryChannelOptions.hpp"
+#include "assfire/logger/api/Logger.hpp"
+#include "assfire/messenger/api/ChannelId.hpp"
+#include "assfire/messenger/api/Consumer.hpp"
+#include "assfire/messenger/impl/util/MpmcRingBuffer.hpp"
+#include "assfire/messenger/impl/util/SpscRingBuffer.hpp"
+#include "assfire/messenger/impl/util/WakeupNotifier.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <oneapi/tbb/task_arena.h>
+#include <string>
+#include <vector>
+
+namespace assfire::messenger {
+    // Consuming end of an in-process channel which also owns channel's ring buffer. Publishers of the channel push into it directly.
+    // Polled messages get delivery metadata with channel name as topic, partition 0 and position in channel as offset.
+    // Messages aren't redelivered, so ack only validates the message and counts it
+    class InMemoryConsumer : public Consumer {
+      public:
+        InMemoryConsumer(ChannelId channel_id, InMemoryChannelOptions options, std::shared_ptr<tbb::task_arena> handlers_arena = nullptr);
+        ~InMemoryConsumer();
+
+        virtual Message poll() override;
+        virtual Message poll(std::chrono::milliseconds timeout) override;
+        virtual std::size_t poll_batch(std::vector<Message>& messages, std::size_t max_messages, std::chrono::milliseconds timeout) override;
+        virtual void ack(const Message& msg) override;
+        virtual void pause() override;
+        virtual void resume() override;
+        virtual void stop() override;
+        virtual void drain() override;
+        virtual void subscribe(MessageHandler handler, std::size_t concurrency) override;
+        virtual std::size_t try_poll_batch(std::vector<Message>& messages, std::size_t max_messages) override;
+        virtual std::uint64_t notify_when_readable(std::function<void()> callback) override;
+        virtual bool cancel_readable_notification(std::uint64_t id) override;
+        virtual bool stopped() const override;
+
+        // Blocks while channel is full and returns position of the message in channel. Throws PublisherError once consumer is stopped
+        std::uint64_t push(const Message& msg);
+
+        const InMemoryChannelOptions& options() const {
+            return _options;
+        }
+
+        std::uint64_t acked_messages() const {
+            return _acked_messages.load();
+        }
+
+      private:
+        bool try_push(const Message& msg, std::uint64_t& position);
+        bool try_pop(Message& msg);
+        bool ring_empty() const;
+        bool ring_full() const;
+        bool is_readable() const;
+        void on_pushed();
+        void wait_for_new_messages(std::chrono::milliseconds timeout);
+        void notify_readable();
+        void schedule_handlers();
+        void run_handlers();
+        void handle_message(const Message& msg);
+
+        std::shared_ptr<const std::string> _topic;
+        InMemoryChannelOptions _options;
+        std::unique_ptr<MpmcRingBuffer<Message>> _mpmc_ring;
+        std::unique_ptr<SpscRingBuffer<Message>> _spsc_ring;
+        // Pollers wait for messages, publishers and drain wait for free space
+        WakeupNotifier _readable_notifier;
+        WakeupNotifier _writable_notifier;
+        std::atomic_bool _interrupted;
+        std::atomic_bool _paused;
+        std::atomic<std::uint64_t> _acked_messages;
+        std::mutex _readable_mtx;
+        std::map<std::uint64_t, std::function<void()>> _readable_callbacks;
+        std::uint64_t _next_readable_callback_id = 0;
+        std::atomic_bool _has_readable_callbacks;
+        std::shared_ptr<tbb::task_arena> _handlers_arena;
+        MessageHandler _handler;
+        std::size_t _handler_concurrency = 0;
+        std::atomic_bool _subscribed;
+        // Running handlers hold concurrency slots, handler tasks are counted until they stop touching the consumer
+        std::atomic<std::size_t> _running_handlers;
+        std::size_t _handler_tasks = 0;
+        std::mutex _handlers_mtx;
+        std::condition_variable _handlers_cv;
+        std::shared_ptr<logger::Logger> _logger;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
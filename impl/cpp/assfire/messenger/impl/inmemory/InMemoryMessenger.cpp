@@ -0,0 +1,58 @@
+#include "InMemoryMessenger.hpp"
+
+#include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+
+namespace assfire::messenger {
+
+    InMemoryMessenger::InMemoryMessenger()
+        : _handlers_arena(std::make_shared<tbb::task_arena>()),
+          _logger(logger::LoggerProvider::get("assfire.messenger.InMemoryMessenger")) {}
+
+    std::shared_ptr<Publisher> InMemoryMessenger::get_publisher(const ChannelId& channel_id) {
+        tbb::concurrent_hash_map<ChannelId, Channel>::const_accessor accessor;
+        if (!_channels.find(accessor, channel_id)) {
+            _logger->error("Publisher channel {} is not declared", channel_id.name());
+            throw ChannelNotDeclaredError(channel_id);
+        }
+        return accessor->second.publisher;
+    }
+
+    std::shared_ptr<Consumer> InMemoryMessenger::get_consumer(const ChannelId& channel_id) {
+        tbb::concurrent_hash_map<ChannelId, Channel>::const_accessor accessor;
+        if (!_channels.find(accessor, channel_id)) {
+            _logger->error("Consumer channel {} is not declared", channel_id.name());
+            throw ChannelNotDeclaredError(channel_id);
+        }
+        return accessor->second.consumer;
+    }
+
+    std::shared_ptr<InMemoryConsumer> InMemoryMessenger::create_channel(ChannelId channel_id, InMemoryChannelOptions options) {
+        _logger->info("Creating in-memory channel {} (options: {})", channel_id.name(), options.to_string());
+
+        tbb::concurrent_hash_map<ChannelId, Channel>::accessor write_accessor;
+        bool is_new = _channels.insert(write_accessor, channel_id);
+
+        if (is_new) {
+            auto consumer          = std::make_shared<InMemoryConsumer>(channel_id, std::move(options), _handlers_arena);
+            write_accessor->second = Channel {consumer, std::make_shared<InMemoryPublisher>(consumer)};
+        } else {
+            if (write_accessor->second.consumer->options() != options) {
+                _logger->error("Trying to redeclare existing in-memory channel {} (options = {}) with different options {} - this is not allowed",
+                               channel_id.name(), write_accessor->second.consumer->options().to_string(), options.to_string());
+                throw ChannelRedeclarationAttemptError(channel_id);
+            } else {
+                _logger->info("Found existing in-memory channel {}. It will be reused", channel_id.name());
+            }
+        }
+        return write_accessor->second.consumer;
+    }
+
+    void InMemoryMessenger::destroy_channel(ChannelId channel_id) {
+        tbb::concurrent_hash_map<ChannelId, Channel>::accessor write_accessor;
+        if (!_channels.find(write_accessor, channel_id)) { return; }
+        write_accessor->second.consumer->stop();
+        _channels.erase(write_accessor);
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "InMemoryChannelOptions.hpp"
+#include "InMemoryConsumer.hpp"
+#include "InMemoryPublisher.hpp"
+#include "assfire/logger/api/Logger.hpp"
+#include "assfire/messenger/api/Messenger.hpp"
+
+#include <memory>
+#include <oneapi/tbb/concurrent_hash_map.h>
+#include <oneapi/tbb/task_arena.h>
+
+namespace assfire::messenger {
+    // Messenger for components living in the same process. Publisher and consumer obtained for the same channel id
+    // share a bounded lock-free ring buffer, so messages never leave the process and payloads are never copied
+    class InMemoryMessenger : public Messenger {
+      public:
+        InMemoryMessenger();
+
+        virtual std::shared_ptr<Publisher> get_publisher(const ChannelId& channel_id) override;
+        virtual std::shared_ptr<Consumer> get_consumer(const ChannelId& channel_id) override;
+
+        std::shared_ptr<InMemoryConsumer> create_channel(ChannelId channel_id, InMemoryChannelOptions options = InMemoryChannelOptions());
+
+        // Stops channel's consumer, so publishers still holding the channel fail instead of blocking on a full ring
+        void destroy_channel(ChannelId channel_id);
+
+      private:
+        struct Channel {
+            std::shared_ptr<InMemoryConsumer> consumer;
+            std::shared_ptr<InMemoryPublisher> publisher;
+        };
+
+        // Subscription handlers of all channels share this arena, so idle channels don't occupy threads
+        std::shared_ptr<tbb::task_arena> _handlers_arena;
+        tbb::concurrent_hash_map<ChannelId, Channel> _channels;
+        std::shared_ptr<logger::Logger> _logger;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
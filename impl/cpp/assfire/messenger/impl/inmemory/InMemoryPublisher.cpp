@@ -0,0 +1,34 @@
+#include "InMemoryPublisher.hpp"
+
+#include "assfire/messenger/api/Exceptions.hpp"
+
+namespace assfire::messenger {
+
+    InMemoryPublisher::InMemoryPublisher(std::shared_ptr<InMemoryConsumer> consumer) : _consumer(std::move(consumer)) {}
+
+    void InMemoryPublisher::publish(const Message& msg) {
+        _consumer->push(msg);
+    }
+
+    void InMemoryPublisher::publish(const Message& msg, DeliveryCallback callback) {
+        std::uint64_t position = 0;
+        try {
+            position = _consumer->push(msg);
+        } catch (const PublisherError& e) {
+            callback(DeliveryReport(e.what()));
+            return;
+        }
+        callback(DeliveryReport(0, static_cast<std::int64_t>(position)));
+    }
+
+    PublishBatchResult InMemoryPublisher::publish_batch(std::span<const Message> messages) {
+        std::vector<PublishFailure> failures;
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            try {
+                _consumer->push(messages[i]);
+            } catch (const PublisherError& e) { failures.emplace_back(i, e.what()); }
+        }
+        return PublishBatchResult(messages.size(), std::move(failures));
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
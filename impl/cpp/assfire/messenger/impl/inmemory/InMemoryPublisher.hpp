@@ -0,0 +1,23 @@
+#pragma once
+
+#include "InMemoryConsumer.hpp"
+#include "assfire/messenger/api/Publisher.hpp"
+
+#include <memory>
+
+namespace assfire::messenger {
+    // Publishing end of an in-process channel. Message is delivered as soon as it is put into channel's ring buffer,
+    // so delivery callbacks are invoked synchronously by publish
+    class InMemoryPublisher : public Publisher {
+      public:
+        explicit InMemoryPublisher(std::shared_ptr<InMemoryConsumer> consumer);
+
+        using Publisher::publish;
+        virtual void publish(const Message& msg) override;
+        virtual void publish(const Message& msg, DeliveryCallback callback) override;
+        virtual PublishBatchResult publish_batch(std::span<const Message> messages) override;
+
+      private:
+        std::shared_ptr<InMemoryConsumer> _consumer;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "assfire/logger/impl/spdlog/SpdlogLoggerFactory.hpp"
+#include "assfire/messenger/impl/inmemory/InMemoryMessenger.hpp"
+
+#include <benchmark/benchmark.h>
+#include <thread>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+namespace {
+    InMemoryChannelOptions channel_options(bool single_producer_single_consumer) {
+        InMemoryChannelOptions options;
+        options.set_capacity(4096);
+        options.set_single_producer(single_producer_single_consumer);
+        options.set_single_consumer(single_producer_single_consumer);
+        return options;
+    }
+} // namespace
+
+// Publish and poll of one message on the same thread - the cost of passing a message through a channel
+static void InMemoryMessenger_PublishPoll(benchmark::State& state) {
+    assfire::logger::SpdlogLoggerFactory::register_static_factory();
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel"), channel_options(state.range(0) != 0));
+    auto publisher = messenger.get_publisher(ChannelId("channel"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel"));
+
+    Message msg(pack("Benchmark payload"));
+    for (auto _ : state) {
+        publisher->publish(msg);
+        benchmark::DoNotOptimize(consumer->poll(1s));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(InMemoryMessenger_PublishPoll)->Arg(0)->Arg(1);
+
+// Publisher and consumer on separate threads, measures sustained channel throughput
+static void InMemoryMessenger_Throughput(benchmark::State& state) {
+    assfire::logger::SpdlogLoggerFactory::register_static_factory();
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel"), channel_options(state.range(0) != 0));
+    auto publisher = messenger.get_publisher(ChannelId("channel"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel"));
+
+    constexpr std::size_t batch_size = 1000;
+    Message msg(pack("Benchmark payload"));
+    std::vector<Message> received;
+    received.reserve(batch_size);
+    for (auto _ : state) {
+        std::thread producer([&] {
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                publisher->publish(msg);
+            }
+        });
+        for (std::size_t polled = 0; polled < batch_size;) {
+            received.clear();
+            polled += consumer->poll_batch(received, batch_size - polled, 1s);
+        }
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(InMemoryMessenger_Throughput)->Arg(0)->Arg(1)->UseRealTime();
\ No newline at end of file
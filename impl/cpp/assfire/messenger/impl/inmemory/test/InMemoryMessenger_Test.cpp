@@ -0,0 +1,292 @@
+#include "assfire/logger/impl/spdlog/SpdlogLoggerFactory.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+#include "assfire/messenger/api/benchmark/BenchmarkMessage.pb.h"
+#include "assfire/messenger/impl/inmemory/InMemoryMessenger.hpp"
+
+#include <condition_variable>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+using InMemoryMessage = assfire::messenger::Message;
+using assfire::messenger::benchmarks::BenchmarkMessage;
+
+class InMemoryMessengerTest : public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        assfire::logger::SpdlogLoggerFactory::register_static_factory();
+    }
+};
+
+TEST_F(InMemoryMessengerTest, Messenger_MessagesAreSentAndReceivedInOrder) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"));
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    EXPECT_THROW(consumer->poll(10ms), TimeoutError);
+
+    publisher->publish(InMemoryMessage(pack("Test message 1")));
+    publisher->publish(InMemoryMessage(pack("Test message 2")));
+
+    InMemoryMessage received_msg1 = consumer->poll(1s);
+    InMemoryMessage received_msg2 = consumer->poll(1s);
+
+    EXPECT_EQ(to_string_view(received_msg1.payload()), "Test message 1");
+    EXPECT_EQ(to_string_view(received_msg2.payload()), "Test message 2");
+    ASSERT_TRUE(received_msg1.delivery_metadata());
+    EXPECT_EQ(received_msg1.delivery_metadata()->topic(), "channel1");
+    EXPECT_EQ(received_msg1.delivery_metadata()->offset(), 0);
+    EXPECT_EQ(received_msg2.delivery_metadata()->offset(), 1);
+
+    consumer->ack(received_msg1);
+    consumer->ack(received_msg2);
+    EXPECT_THROW(consumer->ack(InMemoryMessage(pack("Never published"))), AckFailedError);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_UndeclaredChannelCannotBeUsed) {
+    InMemoryMessenger messenger;
+
+    EXPECT_THROW(messenger.get_publisher(ChannelId("channel1")), ChannelNotDeclaredError);
+    EXPECT_THROW(messenger.get_consumer(ChannelId("channel1")), ChannelNotDeclaredError);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_RedeclarationOfChannelWithDifferentOptionsIsNotAllowed) {
+    InMemoryMessenger messenger;
+
+    InMemoryChannelOptions options;
+    options.set_capacity(16);
+    auto consumer = messenger.create_channel(ChannelId("channel1"), options);
+    EXPECT_EQ(messenger.create_channel(ChannelId("channel1"), options), consumer);
+
+    options.set_capacity(32);
+    EXPECT_THROW(messenger.create_channel(ChannelId("channel1"), options), ChannelRedeclarationAttemptError);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_PublisherIsBlockedWhileChannelIsFull) {
+    InMemoryMessenger messenger;
+
+    InMemoryChannelOptions options;
+    options.set_capacity(2);
+    messenger.create_channel(ChannelId("channel1"), options);
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    publisher->publish(InMemoryMessage(pack("Test message 1")));
+    publisher->publish(InMemoryMessage(pack("Test message 2")));
+
+    std::atomic_bool published(false);
+    std::thread blocked_publisher([&] {
+        publisher->publish(InMemoryMessage(pack("Test message 3")));
+        published = true;
+    });
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(published);
+
+    EXPECT_EQ(to_string_view(consumer->poll(1s).payload()), "Test message 1");
+    blocked_publisher.join();
+    EXPECT_TRUE(published);
+
+    EXPECT_EQ(to_string_view(consumer->poll(1s).payload()), "Test message 2");
+    EXPECT_EQ(to_string_view(consumer->poll(1s).payload()), "Test message 3");
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_PausedConsumerReceivesNothingUntilResumed) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"));
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    consumer->pause();
+    publisher->publish(InMemoryMessage(pack("Test message 1")));
+    EXPECT_THROW(consumer->poll(20ms), TimeoutError);
+
+    std::thread resumer([&] {
+        std::this_thread::sleep_for(20ms);
+        consumer->resume();
+    });
+    EXPECT_EQ(to_string_view(consumer->poll(1s).payload()), "Test message 1");
+    resumer.join();
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_DrainWaitsUntilAllMessagesArePolled) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"));
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    for (int i = 0; i < 10; ++i) {
+        publisher->publish(InMemoryMessage(pack("Test message")));
+    }
+
+    std::thread poller([&] {
+        std::vector<InMemoryMessage> messages;
+        while (messages.size() < 10) {
+            consumer->poll_batch(messages, 3, 1s);
+        }
+    });
+    consumer->drain();
+    poller.join();
+
+    std::vector<InMemoryMessage> messages;
+    EXPECT_EQ(consumer->try_poll_batch(messages, 10), 0);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_StoppedChannelRejectsPublishing) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"));
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    messenger.destroy_channel(ChannelId("channel1"));
+
+    EXPECT_THROW(publisher->publish(InMemoryMessage(pack("Test message 1"))), PublisherError);
+    EXPECT_FALSE(publisher->publish_async(InMemoryMessage(pack("Test message 2"))).get().ok());
+    EXPECT_THROW(messenger.get_publisher(ChannelId("channel1")), ChannelNotDeclaredError);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_ReadableCallbackIsInvokedOnPublish) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"));
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    std::atomic<int> notifications(0);
+    consumer->notify_when_readable([&] { notifications.fetch_add(1); });
+    EXPECT_EQ(notifications.load(), 0);
+
+    publisher->publish(InMemoryMessage(pack("Test message 1")));
+    EXPECT_EQ(notifications.load(), 1);
+
+    consumer->notify_when_readable([&] { notifications.fetch_add(1); });
+    EXPECT_EQ(notifications.load(), 2);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_ReadableCallbacksAreInvokedOnStopUnlessCancelled) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"));
+    auto consumer = messenger.get_consumer(ChannelId("channel1"));
+
+    std::atomic<int> notifications(0);
+    consumer->notify_when_readable([&] { notifications.fetch_add(1); });
+    std::uint64_t cancelled = consumer->notify_when_readable([&] { notifications.fetch_add(10); });
+    EXPECT_TRUE(consumer->cancel_readable_notification(cancelled));
+    EXPECT_FALSE(consumer->cancel_readable_notification(cancelled));
+
+    EXPECT_FALSE(consumer->stopped());
+    consumer->stop();
+    EXPECT_TRUE(consumer->stopped());
+    EXPECT_EQ(notifications.load(), 1);
+
+    consumer->notify_when_readable([&] { notifications.fetch_add(1); });
+    EXPECT_EQ(notifications.load(), 2);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_SubscribedHandlerReceivesMessages) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"));
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+
+    constexpr int concurrency = 2;
+    std::mutex mtx;
+    std::condition_variable handled_cv;
+    std::unordered_set<std::string> messages;
+
+    messenger.subscribe(
+        ChannelId("channel1"),
+        [&](const InMemoryMessage& msg) {
+            std::lock_guard<std::mutex> lck(mtx);
+            messages.emplace(to_string_view(msg.payload()));
+            handled_cv.notify_all();
+        },
+        concurrency);
+
+    publisher->publish(InMemoryMessage(pack("Test message 1")));
+    publisher->publish(InMemoryMessage(pack("Test message 2")));
+    publisher->publish(InMemoryMessage(pack("Test message 3")));
+
+    std::unique_lock<std::mutex> lck(mtx);
+    ASSERT_TRUE(handled_cv.wait_for(lck, 30s, [&] { return messages.size() == 3; }));
+    lck.unlock();
+
+    auto consumer = messenger.create_channel(ChannelId("channel1"));
+    consumer->stop();
+    EXPECT_EQ(consumer->acked_messages(), 3);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_ConsumerIsStoppedFromSubscribedHandler) {
+    InMemoryMessenger messenger;
+    auto consumer = messenger.create_channel(ChannelId("channel1"));
+
+    std::promise<void> stopped;
+    std::atomic_bool stop_called(false);
+    messenger.subscribe(ChannelId("channel1"), [&](const InMemoryMessage& msg) {
+        if (stop_called.exchange(true)) { return; }
+        consumer->stop();
+        stopped.set_value();
+    });
+
+    messenger.get_publisher(ChannelId("channel1"))->publish(InMemoryMessage(pack("Test message")));
+
+    EXPECT_EQ(stopped.get_future().wait_for(10s), std::future_status::ready);
+    EXPECT_TRUE(consumer->stopped());
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_SingleProducerSingleConsumerChannelKeepsOrder) {
+    InMemoryMessenger messenger;
+
+    InMemoryChannelOptions options;
+    options.set_capacity(8);
+    options.set_single_producer(true);
+    options.set_single_consumer(true);
+    messenger.create_channel(ChannelId("channel1"), options);
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    constexpr int messages_count = 1000;
+    std::thread producer([&] {
+        for (int i = 0; i < messages_count; ++i) {
+            publisher->publish(InMemoryMessage(pack(std::to_string(i))));
+        }
+    });
+
+    for (int i = 0; i < messages_count; ++i) {
+        InMemoryMessage msg = consumer->poll(1s);
+        ASSERT_EQ(to_string_view(msg.payload()), std::to_string(i));
+        ASSERT_EQ(msg.delivery_metadata()->offset(), i);
+    }
+    producer.join();
+
+    EXPECT_THROW(consumer->subscribe([](const InMemoryMessage&) {}, 2), ConsumerError);
+}
+
+TEST_F(InMemoryMessengerTest, Messenger_ProtobufsArePublishedWithoutIntermediateMessage) {
+    InMemoryMessenger messenger;
+    messenger.create_channel(ChannelId("channel"), InMemoryChannelOptions());
+    auto publisher = messenger.get_publisher(ChannelId("channel"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel"));
+
+    BenchmarkMessage proto;
+    proto.set_id("Test message 1");
+    proto.add_coordinates(1.5);
+    publisher->publish(proto);
+    publisher->publish(BenchmarkMessage());
+
+    BenchmarkMessage received = unpack<BenchmarkMessage>(consumer->poll(1s).payload());
+    EXPECT_EQ(received.id(), "Test message 1");
+    ASSERT_EQ(received.coordinates_size(), 1);
+    EXPECT_EQ(received.coordinates(0), 1.5);
+    EXPECT_EQ(unpack<BenchmarkMessage>(consumer->poll(1s).payload()).id(), "");
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "KafkaCodecProbe.hpp"
+#include "KafkaOptions.hpp"
+
+#include <absl/strings/str_join.h>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace assfire::messenger {
+    class KafkaAdaptiveCompressionOptions {
+      public:
+        using Probes = std::map<KafkaOptions::CompressionTypeEnum, std::shared_ptr<const KafkaCodecProbe>>;
+
+        KafkaAdaptiveCompressionOptions()                                           = default;
+        KafkaAdaptiveCompressionOptions(const KafkaAdaptiveCompressionOptions &rhs) = default;
+        KafkaAdaptiveCompressionOptions(KafkaAdaptiveCompressionOptions &&rhs)      = default;
+
+        KafkaAdaptiveCompressionOptions &operator=(const KafkaAdaptiveCompressionOptions &rhs) = default;
+        KafkaAdaptiveCompressionOptions &operator=(KafkaAdaptiveCompressionOptions &&rhs) = default;
+
+        bool operator==(const KafkaAdaptiveCompressionOptions &rhs) const = default;
+
+        std::string to_string() const {
+            std::vector<std::string> codecs;
+            for (const auto &[codec, probe] : _probes) {
+                codecs.push_back(KafkaOptions::CompressionType::name_of(codec));
+            }
+            return "{sample_interval = " + std::to_string(_sample_interval) + ",sample_window = " + std::to_string(_sample_window) +
+                   ",reselection_interval = " + std::to_string(_reselection_interval) +
+                   ",min_saved_bytes_per_cpu_us = " + std::to_string(_min_saved_bytes_per_cpu_us) + ",probes = [" + absl::StrJoin(codecs, ",") + "]}";
+        }
+
+        // Every sample_interval-th published message is compressed by all probes
+        std::size_t sample_interval() const {
+            return _sample_interval;
+        }
+        void set_sample_interval(std::size_t sample_interval) {
+            _sample_interval = sample_interval;
+        }
+
+        // Number of sampled messages after which codec of the channel is chosen
+        std::size_t sample_window() const {
+            return _sample_window;
+        }
+        void set_sample_window(std::size_t sample_window) {
+            _sample_window = sample_window;
+        }
+
+        // Number of messages sampled with chosen codec after which all probes sample another window and codec is chosen again,
+        // so publisher follows payloads whose compressibility changes. Zero chooses codec once per publisher
+        std::size_t reselection_interval() const {
+            return _reselection_interval;
+        }
+        void set_reselection_interval(std::size_t reselection_interval) {
+            _reselection_interval = reselection_interval;
+        }
+
+        // Codec is worth its CPU cost only if it saves at least this many bytes per microsecond spent compressing.
+        // Codec saving most bytes among those worth their cost is chosen, or no compression if there are none
+        double min_saved_bytes_per_cpu_us() const {
+            return _min_saved_bytes_per_cpu_us;
+        }
+        void set_min_saved_bytes_per_cpu_us(double min_saved_bytes_per_cpu_us) {
+            _min_saved_bytes_per_cpu_us = min_saved_bytes_per_cpu_us;
+        }
+
+        // Candidate codecs, gzip and lz4 by default. Zstd has no built-in probe, as neither this package nor its librdkafka build
+        // depend on zstd library. It becomes a candidate once its probe is given, which is only useful with librdkafka built with zstd
+        const Probes &probes() const {
+            return _probes;
+        }
+        void set_probes(Probes probes) {
+            _probes = std::move(probes);
+        }
+
+      private:
+        // Shared by default options, so they compare equal
+        static const std::shared_ptr<const KafkaCodecProbe> &gzip_probe() {
+            static const std::shared_ptr<const KafkaCodecProbe> probe = std::make_shared<KafkaGzipProbe>();
+            return probe;
+        }
+        static const std::shared_ptr<const KafkaCodecProbe> &lz4_probe() {
+            static const std::shared_ptr<const KafkaCodecProbe> probe = std::make_shared<KafkaLz4Probe>();
+            return probe;
+        }
+
+        std::size_t _sample_interval       = 100;
+        std::size_t _sample_window         = 100;
+        std::size_t _reselection_interval  = 10000;
+        double _min_saved_bytes_per_cpu_us = 8;
+        Probes _probes = {{KafkaOptions::CompressionTypeEnum::GZIP, gzip_probe()}, {KafkaOptions::CompressionTypeEnum::LZ4, lz4_probe()}};
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "KafkaCodecProbe.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <zlib.h>
+
+namespace assfire::messenger {
+
+    namespace {
+        // Librdkafka writes independent 64KB blocks without checksums, framed by magic, descriptor and end mark
+        constexpr std::size_t LZ4_BLOCK_SIZE   = 64 * 1024;
+        constexpr std::size_t LZ4_FRAME_HEADER = 7;
+        constexpr std::size_t LZ4_END_MARK     = 4;
+        constexpr std::size_t LZ4_BLOCK_HEADER = 4;
+        // Lz4 block format limits: matches are at least 4 bytes long and 64KB far, block ends with literals
+        constexpr std::size_t LZ4_MIN_MATCH     = 4;
+        constexpr std::size_t LZ4_MAX_DISTANCE  = 65535;
+        constexpr std::size_t LZ4_LAST_LITERALS = 5;
+        constexpr std::size_t LZ4_MATCH_LIMIT   = 12;
+        constexpr int LZ4_HASH_LOG              = 12;
+        constexpr std::uint32_t LZ4_NO_POSITION = 0xFFFFFFFF;
+
+        std::uint32_t read_u32(const std::uint8_t* data) {
+            std::uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        // Bytes of length which doesn't fit into 4 bits of sequence token
+        std::size_t lz4_length_size(std::size_t length) {
+            return length >= 15 ? (length - 15) / 255 + 1 : 0;
+        }
+
+        std::size_t lz4_literals_size(std::size_t literals) {
+            return 1 + lz4_length_size(literals) + literals;
+        }
+
+        // Greedy single-probe hash matching, as in lz4's fast mode
+        std::size_t lz4_block_size(const std::uint8_t* block, std::size_t size, std::vector<std::uint32_t>& positions) {
+            if (size <= LZ4_MATCH_LIMIT) { return lz4_literals_size(size); }
+
+            std::fill(positions.begin(), positions.end(), LZ4_NO_POSITION);
+            std::size_t compressed = 0;
+            std::size_t anchor     = 0;
+            std::size_t pos        = 0;
+            while (pos < size - LZ4_MATCH_LIMIT) {
+                std::uint32_t sequence  = read_u32(block + pos);
+                std::uint32_t& position = positions[(sequence * 2654435761U) >> (32 - LZ4_HASH_LOG)];
+                std::uint32_t candidate = position;
+                position                = static_cast<std::uint32_t>(pos);
+                if (candidate == LZ4_NO_POSITION || pos - candidate > LZ4_MAX_DISTANCE || read_u32(block + candidate) != sequence) {
+                    ++pos;
+                    continue;
+                }
+
+                std::size_t length = LZ4_MIN_MATCH;
+                while (pos + length < size - LZ4_LAST_LITERALS && block[candidate + length] == block[pos + length]) {
+                    ++length;
+                }
+                compressed += lz4_literals_size(pos - anchor) + 2 + lz4_length_size(length - LZ4_MIN_MATCH);
+                pos        += length;
+                anchor      = pos;
+            }
+            return compressed + lz4_literals_size(size - anchor);
+        }
+    } // namespace
+
+    std::size_t KafkaGzipProbe::compressed_size(std::span<const std::uint8_t> payload, std::optional<std::int32_t> level) const {
+        z_stream stream {};
+        // Window bits above 15 make zlib write gzip header and trailer, as librdkafka does
+        if (deflateInit2(&stream, std::min(level.value_or(Z_DEFAULT_COMPRESSION), 9), Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("Failed to initialize gzip compression");
+        }
+
+        thread_local std::vector<std::uint8_t> output;
+        output.resize(deflateBound(&stream, static_cast<uLong>(payload.size())));
+        stream.next_in   = const_cast<Bytef*>(payload.data());
+        stream.avail_in  = static_cast<uInt>(payload.size());
+        stream.next_out  = output.data();
+        stream.avail_out = static_cast<uInt>(output.size());
+
+        int result       = deflate(&stream, Z_FINISH);
+        std::size_t size = stream.total_out;
+        deflateEnd(&stream);
+        if (result != Z_STREAM_END) { throw std::runtime_error("Failed to compress payload with gzip"); }
+        return size;
+    }
+
+    // Blocks which don't shrink are stored uncompressed
+    std::size_t KafkaLz4Probe::compressed_size(std::span<const std::uint8_t> payload, std::optional<std::int32_t> level) const {
+        thread_local std::vector<std::uint32_t> positions(std::size_t(1) << LZ4_HASH_LOG);
+
+        std::size_t size = LZ4_FRAME_HEADER + LZ4_END_MARK;
+        for (std::size_t offset = 0; offset < payload.size(); offset += LZ4_BLOCK_SIZE) {
+            std::size_t block_size = std::min(LZ4_BLOCK_SIZE, payload.size() - offset);
+            size += LZ4_BLOCK_HEADER + std::min(block_size, lz4_block_size(payload.data() + offset, block_size, positions));
+        }
+        return size;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
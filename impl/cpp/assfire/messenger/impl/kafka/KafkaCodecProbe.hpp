@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace assfire::messenger {
+    // In-process implementation of a codec librdkafka compresses message batches with, used to estimate
+    // how well and how fast the codec compresses payloads of a channel
+    class KafkaCodecProbe {
+      public:
+        virtual ~KafkaCodecProbe() = default;
+
+        // Returns size of compressed payload. Level is compression.level of publisher, empty for codec's default
+        virtual std::size_t compressed_size(std::span<const std::uint8_t> payload, std::optional<std::int32_t> level) const = 0;
+    };
+
+    // Probe of gzip codec backed by zlib, which librdkafka uses for gzip too
+    class KafkaGzipProbe : public KafkaCodecProbe {
+      public:
+        virtual std::size_t compressed_size(std::span<const std::uint8_t> payload, std::optional<std::int32_t> level) const override;
+    };
+
+    // Probe of lz4 codec. Lz4 library is only bundled inside librdkafka, so payload is matched the way lz4's default fast mode does
+    // and size of librdkafka's lz4 frame is counted without writing it. Level is ignored: high compression levels are estimated as fast mode
+    class KafkaLz4Probe : public KafkaCodecProbe {
+      public:
+        virtual std::size_t compressed_size(std::span<const std::uint8_t> payload, std::optional<std::int32_t> level) const override;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace assfire::messenger {
+    class KafkaCommitStats {
+      public:
+        KafkaCommitStats() = default;
+        KafkaCommitStats(std::uint64_t commits, std::uint64_t failures, std::chrono::microseconds total_latency,
+                         std::chrono::microseconds max_latency, std::chrono::microseconds last_latency)
+            : _commits(commits),
+              _failures(failures),
+              _total_latency(total_latency),
+              _max_latency(max_latency),
+              _last_latency(last_latency) {}
+        KafkaCommitStats(const KafkaCommitStats& rhs) = default;
+        KafkaCommitStats(KafkaCommitStats&& rhs)      = default;
+
+        KafkaCommitStats& operator=(const KafkaCommitStats& rhs) = default;
+        KafkaCommitStats& operator=(KafkaCommitStats&& rhs) = default;
+
+        // Number of offset commit requests sent to broker, including failed ones
+        std::uint64_t commits() const {
+            return _commits;
+        }
+
+        std::uint64_t failures() const {
+            return _failures;
+        }
+
+        std::chrono::microseconds average_latency() const {
+            if (_commits == 0) { return std::chrono::microseconds(0); }
+            return std::chrono::microseconds(_total_latency.count() / static_cast<std::int64_t>(_commits));
+        }
+
+        std::chrono::microseconds max_latency() const {
+            return _max_latency;
+        }
+
+        std::chrono::microseconds last_latency() const {
+            return _last_latency;
+        }
+
+      private:
+        std::uint64_t _commits  = 0;
+        std::uint64_t _failures = 0;
+        std::chrono::microseconds _total_latency {0};
+        std::chrono::microseconds _max_latency {0};
+        std::chrono::microseconds _last_latency {0};
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "KafkaCompressionSelector.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace assfire::messenger {
+
+    KafkaCompressionSelector::KafkaCompressionSelector(KafkaAdaptiveCompressionOptions options, KafkaOptions::CompressionTypeEnum codec,
+                                                       std::optional<std::int32_t> level)
+        : _options(std::move(options)),
+          _level(level),
+          _published(0),
+          _codec(codec) {}
+
+    // Probes run without lock held, so publishers sampling at the same time compress their payloads in parallel
+    std::optional<KafkaOptions::CompressionTypeEnum> KafkaCompressionSelector::sample(std::span<const std::uint8_t> payload) {
+        if (_published.fetch_add(1, std::memory_order_relaxed) % std::max<std::size_t>(_options.sample_interval(), 1) != 0) { return std::nullopt; }
+
+        std::optional<KafkaOptions::CompressionTypeEnum> selected_codec;
+        {
+            std::lock_guard<std::mutex> lck(_mtx);
+            if (!_evaluating) { selected_codec = _codec; }
+        }
+
+        std::map<KafkaOptions::CompressionTypeEnum, Totals> sampled;
+        if (selected_codec) {
+            auto it = _options.probes().find(*selected_codec);
+            if (it != _options.probes().end()) { probe(*it->second, payload, sampled[*selected_codec]); }
+        } else {
+            for (const auto& [codec, codec_probe] : _options.probes()) {
+                probe(*codec_probe, payload, sampled[codec]);
+            }
+        }
+
+        std::lock_guard<std::mutex> lck(_mtx);
+        // Samples taken by probes of the previous window are dropped, so every window is evaluated on its own samples
+        if (selected_codec.has_value() == _evaluating) { return std::nullopt; }
+        ++_sampled_messages;
+        ++_window_messages;
+        for (const auto& [codec, totals] : sampled) {
+            Totals& codec_totals          = _totals[codec];
+            codec_totals.original_bytes   += totals.original_bytes;
+            codec_totals.compressed_bytes += totals.compressed_bytes;
+            codec_totals.cpu_ns           += totals.cpu_ns;
+        }
+        if (!_evaluating) {
+            if (_options.reselection_interval() > 0 && _window_messages >= _options.reselection_interval()) {
+                _evaluating      = true;
+                _window_messages = 0;
+                _totals.clear();
+            }
+            return std::nullopt;
+        }
+        if (_window_messages < _options.sample_window()) { return std::nullopt; }
+
+        _selected                                = true;
+        _evaluating                              = false;
+        _window_messages                         = 0;
+        KafkaOptions::CompressionTypeEnum chosen = choose();
+        if (chosen == _codec) { return std::nullopt; }
+        _codec = chosen;
+        return chosen;
+    }
+
+    KafkaCompressionStats KafkaCompressionSelector::stats() const {
+        std::lock_guard<std::mutex> lck(_mtx);
+        std::optional<double> ratio;
+        auto it = _totals.find(_codec);
+        if (it != _totals.end() && it->second.compressed_bytes > 0) {
+            ratio = static_cast<double>(it->second.original_bytes) / static_cast<double>(it->second.compressed_bytes);
+        }
+        return KafkaCompressionStats(_codec, ratio, _sampled_messages, _selected);
+    }
+
+    void KafkaCompressionSelector::probe(const KafkaCodecProbe& probe, std::span<const std::uint8_t> payload, Totals& totals) const {
+        auto start_time         = std::chrono::steady_clock::now();
+        std::size_t compressed  = probe.compressed_size(payload, _level);
+        auto cpu_time           = std::chrono::steady_clock::now() - start_time;
+        totals.original_bytes   += payload.size();
+        totals.compressed_bytes += compressed;
+        totals.cpu_ns           += std::chrono::duration_cast<std::chrono::nanoseconds>(cpu_time).count();
+    }
+
+    KafkaOptions::CompressionTypeEnum KafkaCompressionSelector::choose() const {
+        KafkaOptions::CompressionTypeEnum chosen = KafkaOptions::CompressionTypeEnum::NONE;
+        double max_saved_bytes                   = 0;
+        for (const auto& [codec, totals] : _totals) {
+            double saved_bytes = static_cast<double>(totals.original_bytes) - static_cast<double>(totals.compressed_bytes);
+            double cpu_us      = std::max(static_cast<double>(totals.cpu_ns) / 1000.0, 1e-3);
+            if (saved_bytes > max_saved_bytes && saved_bytes / cpu_us >= _options.min_saved_bytes_per_cpu_us()) {
+                chosen          = codec;
+                max_saved_bytes = saved_bytes;
+            }
+        }
+        return chosen;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
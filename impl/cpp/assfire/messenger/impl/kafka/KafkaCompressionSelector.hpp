@@ -0,0 +1,48 @@
+#pragma once
+
+#include "KafkaAdaptiveCompressionOptions.hpp"
+#include "KafkaCompressionStats.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+
+namespace assfire::messenger {
+    // Chooses compression codec of a channel from sampled payloads. Sampling is skipped with a single relaxed increment
+    // for all but every sample_interval-th message. Once the codec is chosen, only it is sampled to keep its ratio up to date
+    // until reselection interval passes and all probes sample the next window
+    class KafkaCompressionSelector {
+      public:
+        KafkaCompressionSelector(KafkaAdaptiveCompressionOptions options, KafkaOptions::CompressionTypeEnum codec, std::optional<std::int32_t> level);
+
+        // Returns codec to switch to when it was just chosen and differs from current one. Thread-safe
+        std::optional<KafkaOptions::CompressionTypeEnum> sample(std::span<const std::uint8_t> payload);
+
+        KafkaCompressionStats stats() const;
+
+      private:
+        struct Totals {
+            std::uint64_t original_bytes   = 0;
+            std::uint64_t compressed_bytes = 0;
+            std::uint64_t cpu_ns           = 0;
+        };
+
+        void probe(const KafkaCodecProbe& probe, std::span<const std::uint8_t> payload, Totals& totals) const;
+        KafkaOptions::CompressionTypeEnum choose() const;
+
+        KafkaAdaptiveCompressionOptions _options;
+        std::optional<std::int32_t> _level;
+        std::atomic<std::uint64_t> _published;
+        mutable std::mutex _mtx;
+        KafkaOptions::CompressionTypeEnum _codec;
+        bool _selected                  = false;
+        bool _evaluating                = true;
+        std::uint64_t _sampled_messages = 0;
+        // Messages sampled since current window of all probes or of chosen codec started
+        std::uint64_t _window_messages = 0;
+        std::map<KafkaOptions::CompressionTypeEnum, Totals> _totals;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "KafkaOptions.hpp"
+
+#include <cstdint>
+#include <optional>
+
+namespace assfire::messenger {
+    // Compression of messages sent by a publisher. Ratio is uncompressed to compressed size of sampled payloads
+    // as measured by the probe of current codec, so it only approximates ratio of batches compressed by librdkafka
+    class KafkaCompressionStats {
+      public:
+        KafkaCompressionStats() = default;
+        KafkaCompressionStats(KafkaOptions::CompressionTypeEnum codec, std::optional<double> ratio, std::uint64_t sampled_messages, bool selected)
+            : _codec(codec),
+              _ratio(ratio),
+              _sampled_messages(sampled_messages),
+              _selected(selected) {}
+        KafkaCompressionStats(const KafkaCompressionStats& rhs) = default;
+        KafkaCompressionStats(KafkaCompressionStats&& rhs)      = default;
+
+        KafkaCompressionStats& operator=(const KafkaCompressionStats& rhs) = default;
+        KafkaCompressionStats& operator=(KafkaCompressionStats&& rhs) = default;
+
+        KafkaOptions::CompressionTypeEnum codec() const {
+            return _codec;
+        }
+
+        // Empty if messages aren't compressed or no messages were sampled yet
+        std::optional<double> ratio() const {
+            return _ratio;
+        }
+
+        std::uint64_t sampled_messages() const {
+            return _sampled_messages;
+        }
+
+        // True once codec was chosen by adaptive compression
+        bool selected() const {
+            return _selected;
+        }
+
+      private:
+        KafkaOptions::CompressionTypeEnum _codec = KafkaOptions::CompressionTypeEnum::NONE;
+        std::optional<double> _ratio;
+        std::uint64_t _sampled_messages = 0;
+        bool _selected                  = false;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -1,106 +1,655 @@
 #include "KafkaConsumer.hpp"
 
-#include "KafkaMessageHeaders.hpp"
+#include "KafkaPartitioner.hpp"
+#include "KafkaRecord.hpp"
 #include "assfire/logger/api/LoggerProvider.hpp"
 #include "assfire/messenger/api/Exceptions.hpp"
+#include "assfire/messenger/impl/util/ScopedThreadRole.hpp"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+#include <algorithm>
+#include <librdkafka/rdkafka.h>
 
 namespace assfire::messenger {
 
+    namespace {
+        std::optional<DeliveryMetadata::Timestamp> record_timestamp(const kafka::clients::consumer::ConsumerRecord& record) {
+            kafka::Timestamp timestamp = record.timestamp();
+            if (timestamp.type == kafka::Timestamp::Type::NotAvailable) { return std::nullopt; }
+            return DeliveryMetadata::Timestamp(std::chrono::milliseconds(timestamp.msSinceEpoch));
+        }
+
+        constexpr std::chrono::milliseconds CONSUME_POLL_TIMEOUT = std::chrono::seconds(5);
+        // While fetching is paused poll returns nothing, so it is kept short to notice resume conditions early
+        constexpr std::chrono::milliseconds PAUSED_POLL_TIMEOUT = std::chrono::milliseconds(100);
+        // Handler task yields arena thread to other channels after handling this many messages
+        constexpr std::size_t HANDLER_TASK_BATCH = 64;
+
+        // Roles of consumer's own threads, stop() called from them must not wait for itself
+        constexpr int CONSUME_LOOP_ROLE = 1;
+        constexpr int HANDLER_ROLE      = 2;
+
+        std::string offsets_to_string(const kafka::TopicPartitionOffsets& offsets) {
+            return absl::StrJoin(offsets, ",", [](std::string* out, const auto& offset) {
+                absl::StrAppend(out, offset.first.first, "/", offset.first.second, "@", offset.second);
+            });
+        }
+    } // namespace
+
     KafkaConsumer::~KafkaConsumer() {
         stop();
+        // Worker destroying the consumer from its own handler can't be joined, it returns right after the handler
+        for (auto& worker : _workers) {
+            if (worker.joinable()) { worker.detach(); }
+        }
+        _consumer->close();
     }
 
-    KafkaConsumer::KafkaConsumer(std::shared_ptr<kafka::clients::KafkaConsumer> consumer, KafkaConsumerOptions options)
+    KafkaConsumer::KafkaConsumer(std::shared_ptr<kafka::clients::KafkaConsumer> consumer, KafkaConsumerOptions options,
+                                 std::shared_ptr<tbb::task_arena> handlers_arena)
         : _consumer(consumer),
+          _topic(std::make_shared<const std::string>(options.topic_name())),
+          _record_pool(BufferPool::create(options.record_pool_size())),
+          _handlers_arena(std::move(handlers_arena)),
+          _running_handlers(0),
           _interrupted(false),
           _started(false),
+          _paused(false),
+          _prefetched_messages(0),
+          _prefetched_bytes(0),
+          _last_commit_time(std::chrono::steady_clock::now()),
           _consumer_options(options),
-          _logger(logger::LoggerProvider::get("assfire.messenger.KafkaConsumer")) {}
+          _logger(logger::LoggerProvider::get("assfire.messenger.KafkaConsumer")) {
+        // Statistics are emitted from consume loop's poll, consumer is closed before collector is destroyed
+        if (_consumer_options.statistics_interval_ms().value().value_or(0) > 0) {
+            _consumer->setStatsCallback([this](const std::string& json) { _statistics.on_statistics(json); });
+        }
+    }
 
     Message KafkaConsumer::poll() {
+        Message msg;
+        poll_into(msg);
+        return msg;
+    }
+
+    Message KafkaConsumer::poll(std::chrono::milliseconds timeout) {
+        Message msg;
+        poll_into(msg, timeout);
+        return msg;
+    }
+
+    void KafkaConsumer::poll_into(Message& msg) {
         while (true) {
             try {
-                return poll(std::chrono::minutes(1));
+                poll_into(msg, std::chrono::minutes(1));
+                return;
             } catch (const TimeoutError& e) {
                 // Just waiting for next loop
             }
         }
     }
 
-    Message KafkaConsumer::poll(std::chrono::milliseconds timeout) {
+    // Queued message is moved over the given one, so record it referred to goes back to the pool unless it is shared
+    void KafkaConsumer::poll_into(Message& msg, std::chrono::milliseconds timeout) {
         wait_for_new_messages(timeout);
 
-        Message msg;
         if (!_messages.try_pop(msg)) { throw EndOfStreamError(); }
+        on_message_dequeued(msg);
         on_message_consumed();
-        return msg;
+    }
+
+    std::size_t KafkaConsumer::poll_batch(std::vector<Message>& messages, std::size_t max_messages, std::chrono::milliseconds timeout) {
+        if (max_messages == 0) { return 0; }
+        wait_for_new_messages(timeout);
+
+        std::size_t polled = try_poll_batch(messages, max_messages);
+        if (polled == 0) { throw EndOfStreamError(); }
+        return polled;
+    }
+
+    std::size_t KafkaConsumer::try_poll_batch(std::vector<Message>& messages, std::size_t max_messages) {
+        start_consume_loop();
+
+        std::size_t polled = 0;
+        Message msg;
+        while (polled < max_messages && _messages.try_pop(msg)) {
+            on_message_dequeued(msg);
+            messages.push_back(std::move(msg));
+            ++polled;
+        }
+        if (polled > 0) { on_message_consumed(); }
+        return polled;
+    }
+
+    // Consume loop and stop take callbacks under the same lock after enqueuing messages or interrupting, so callback is either
+    // invoked here because messages are already there or consumer is stopped, or taken by the loop or stop
+    std::uint64_t KafkaConsumer::notify_when_readable(std::function<void()> callback) {
+        start_consume_loop();
+        std::uint64_t id;
+        {
+            std::lock_guard<std::mutex> lck(_readable_mtx);
+            id = ++_next_readable_callback_id;
+            if (_messages.empty() && !_interrupted) {
+                _readable_callbacks.emplace(id, std::move(callback));
+                return id;
+            }
+        }
+        callback();
+        return id;
+    }
+
+    bool KafkaConsumer::cancel_readable_notification(std::uint64_t id) {
+        std::lock_guard<std::mutex> lck(_readable_mtx);
+        return _readable_callbacks.erase(id) > 0;
+    }
+
+    bool KafkaConsumer::stopped() const {
+        return _interrupted;
     }
 
     void KafkaConsumer::ack(const Message& msg) {
+        const std::optional<DeliveryMetadata>& metadata = msg.delivery_metadata();
+        if (!metadata) {
+            _logger->error("Failed to ack message with headers {}: message has no delivery metadata", msg.headers_to_string());
+            throw AckFailedError("Failed to ack message without delivery metadata");
+        }
+
+        if (!owns_partition(metadata->partition())) {
+            _logger->info("Skipping ack of message {}: partition is not assigned to this consumer anymore", metadata->to_string());
+            return;
+        }
+
+        // Committed offset is the offset of the next message to be consumed
+        std::optional<std::int64_t> commit_offset = metadata->offset() + 1;
+        if (tracks_acked_offsets()) { commit_offset = _offset_tracker.ack(metadata->partition(), metadata->offset()); }
+
+        if (_consumer_options.ack_mode() == KafkaAckMode::COALESCED) {
+            std::lock_guard<std::mutex> lck(_commit_mtx);
+            ++_pending_acks;
+            if (commit_offset) { _pending_commits.add(metadata->partition(), *commit_offset); }
+            return;
+        }
+
+        // Preceding offsets are still in flight, offset will be committed by the ack that completes the prefix
+        if (!commit_offset) { return; }
+
+        std::lock_guard<std::mutex> lck(_sync_commit_mtx);
+        // Partition may have been revoked while waiting for preceding commit
+        if (!owns_partition(metadata->partition())) { return; }
+        auto committed = _committed_offsets.find(metadata->partition());
+        if (committed != _committed_offsets.end() && committed->second >= *commit_offset) { return; }
         try {
-            _consumer->commitSync(
-                {{kafka::TopicPartition(*msg.header(KAFKA_HEADER_TOPIC_NAME), decode_partition_header(*msg.header(KAFKA_HEADER_TOPIC_PARTITION))),
-                  decode_offset_header(*msg.header(KAFKA_HEADER_OFFSET))}});
+            _consumer->commitSync({{kafka::TopicPartition(metadata->topic(), metadata->partition()), *commit_offset}});
         } catch (const std::exception& e) {
-            std::string headers_string = msg.headers_to_string();
-            _logger->error("Failed to ack message with headers {}: {}", headers_string, e.what());
-            std::throw_with_nested(AckFailedError("Failed to ack message: " + headers_string));
+            std::string metadata_string = metadata->to_string();
+            _logger->error("Failed to ack message {}: {}", metadata_string, e.what());
+            std::throw_with_nested(AckFailedError("Failed to ack message: " + metadata_string));
         }
+        _committed_offsets[metadata->partition()] = *commit_offset;
     }
 
+    // Applied right away rather than by consume loop, which may be blocked in poll for a while
+    // Kafka consumer is only paused and resumed by consume loop between polls, so the flag is applied there
     void KafkaConsumer::pause() {
-        _consumer->pause();
+        _paused = true;
+        interrupt_consume_poll();
     }
 
     void KafkaConsumer::resume() {
-        _consumer->resume();
+        _paused = false;
+        interrupt_consume_poll();
     }
 
+    // Waits for consume loop and workers to exit, so offsets acked before stop are committed when it returns.
+    // When called from consumer's own thread, that thread is not waited for: it finishes its current message and exits
     void KafkaConsumer::stop() {
         _interrupted = true;
+        {
+            // Wakes revocation waiting for lanes to be drained, workers exit without handling the rest
+            std::lock_guard<std::mutex> lck(_lanes_mtx);
+            _lanes_cv.notify_all();
+        }
+        wake_waiters();
+        if (_work_ftr.valid() && !ScopedThreadRole::current(this, CONSUME_LOOP_ROLE)) { _work_ftr.wait(); }
+        notify_readable();
+        // Message without delivery metadata is never received from kafka, so it is used to wake up worker blocked on its lane
+        for (auto& lane : _lanes) {
+            lane->push(Message());
+        }
+        for (auto& worker : _workers) {
+            if (worker.joinable() && worker.get_id() != std::this_thread::get_id()) { worker.join(); }
+        }
+        {
+            std::size_t own_tasks = ScopedThreadRole::current(this, HANDLER_ROLE) ? 1 : 0;
+            std::unique_lock<std::mutex> lck(_handlers_mtx);
+            _handlers_cv.wait(lck, [&] { return _handler_tasks == own_tasks; });
+        }
+        commit_pending_sync();
+    }
+
+    // Pollers and drainers return once consumer is stopped, consume loop leaves poll without waiting for its timeout
+    void KafkaConsumer::wake_waiters() {
+        {
+            std::lock_guard<std::mutex> lck(_poll_mtx);
+            _poll_cv.notify_all();
+        }
+        _poll_notifier.notify_all();
+        {
+            std::lock_guard<std::mutex> lck(_drain_mtx);
+            _drain_cv.notify_all();
+        }
+        interrupt_consume_poll();
+    }
+
+    // Yield is remembered by the queue, so poll entered right after it returns immediately as well
+    void KafkaConsumer::interrupt_consume_poll() {
+        if (rd_kafka_t* handle = _consumer->getClientHandle()) {
+            rd_kafka_queue_t* queue = rd_kafka_queue_get_consumer(handle);
+            if (queue) {
+                rd_kafka_queue_yield(queue);
+                rd_kafka_queue_destroy(queue);
+            }
+        }
     }
 
     void KafkaConsumer::drain() {
         std::unique_lock<std::mutex> lck(_drain_mtx);
-        _drain_cv.wait(lck, [&] { return _messages.empty(); });
+        _drain_cv.wait(lck, [&] { return _messages.empty() || _interrupted; });
+    }
+
+    void KafkaConsumer::subscribe_topic() {
+        _consumer->subscribe({*_topic}, [this](kafka::clients::consumer::RebalanceEventType event, const kafka::TopicPartitions& partitions) {
+            on_rebalance(event, partitions);
+        });
+    }
+
+    void KafkaConsumer::start_workers(MessageHandler handler) {
+        if (_started || !_lanes.empty()) {
+            _logger->error("Failed to start workers for topic {}: consumer is already started", *_topic);
+            throw ConsumerError("Workers can only be started before consumer is started");
+        }
+
+        std::size_t workers_count = std::max<std::size_t>(_consumer_options.worker_count(), 1);
+        _logger->info("Starting {} workers for topic {}", workers_count, *_topic);
+        for (std::size_t i = 0; i < workers_count; ++i) {
+            _lanes.push_back(std::make_unique<tbb::concurrent_bounded_queue<Message>>());
+        }
+        // Every worker gets its own handler copy, so stateful handlers aren't shared between threads
+        for (std::size_t i = 0; i < workers_count; ++i) {
+            _workers.emplace_back(&KafkaConsumer::work_loop, this, std::ref(*_lanes[i]), handler);
+        }
+        start_consume_loop();
+    }
+
+    void KafkaConsumer::subscribe(MessageHandler handler, std::size_t concurrency) {
+        if (_started) {
+            _logger->error("Failed to subscribe handler to topic {}: consumer is already started", *_topic);
+            throw ConsumerError("Handler can only be subscribed before consumer is started");
+        }
+
+        if (!_handlers_arena) { _handlers_arena = std::make_shared<tbb::task_arena>(); }
+        _handler             = std::move(handler);
+        _handler_concurrency = std::max<std::size_t>(concurrency, 1);
+        start_consume_loop();
     }
 
     const KafkaConsumerOptions& KafkaConsumer::options() {
         return _consumer_options;
     }
 
+    KafkaCommitStats KafkaConsumer::commit_stats() const {
+        std::lock_guard<std::mutex> lck(_commit_mtx);
+        return KafkaCommitStats(_commits, _commit_failures, _total_commit_latency, _max_commit_latency, _last_commit_latency);
+    }
+
+    KafkaLatencyStats KafkaConsumer::latency_stats() const {
+        return KafkaLatencyStats(_broker_to_enqueue_latency.snapshot(), _enqueue_to_dequeue_latency.snapshot());
+    }
+
+    std::optional<KafkaMetrics> KafkaConsumer::metrics() const {
+        return _statistics.metrics();
+    }
+
     void KafkaConsumer::consume_loop() {
+        ScopedThreadRole role(this, CONSUME_LOOP_ROLE);
         while (!_interrupted) {
-            auto records = _consumer->poll(std::chrono::seconds(5));
-            for (const auto& record : records) {
+            update_fetch_state();
+            maybe_commit_async();
+            auto records         = _consumer->poll(consume_poll_timeout());
+            std::size_t received = 0;
+            // Clocks are read once per poll, all records of a poll are queued at virtually the same time
+            auto received_at      = std::chrono::steady_clock::now();
+            auto received_at_wall = std::chrono::system_clock::now();
+            for (auto& record : records) {
                 if (record.value().size() == 0) { continue; }
                 if (!record.error()) {
-                    Message msg(Payload(static_cast<const uint8_t*>(record.value().data()), record.value().size()));
-                    msg.add_header(Header(KAFKA_HEADER_OFFSET, encode_offset_header(record.offset())));
-                    msg.add_header(Header(KAFKA_HEADER_TOPIC_NAME, record.topic()));
-                    msg.add_header(Header(KAFKA_HEADER_TOPIC_PARTITION, encode_partition_header(record.partition())));
-                    _messages.emplace(std::move(msg));
+                    // Payload and headers reference librdkafka message directly, record is kept alive while any message copy refers to it
+                    std::shared_ptr<const KafkaRecord> holder =
+                        std::allocate_shared<KafkaRecord>(PoolAllocator<KafkaRecord>(_record_pool.get()), std::move(record));
+                    Message msg(PayloadBuffer(holder, holder->value_data(), holder->value_size()));
+                    msg.set_record_headers(holder);
+                    auto timestamp = record_timestamp(holder->record());
+                    if (timestamp) {
+                        _broker_to_enqueue_latency.record(std::chrono::duration_cast<std::chrono::microseconds>(received_at_wall - *timestamp));
+                    }
+                    msg.set_delivery_metadata(
+                        DeliveryMetadata(_topic, holder->record().partition(), holder->record().offset(), timestamp, received_at));
+                    kafka::Key key = holder->record().key();
+                    if (key.data()) { msg.set_key(std::string(static_cast<const char*>(key.data()), key.size())); }
+                    if (tracks_acked_offsets()) {
+                        _offset_tracker.on_delivered(holder->record().partition(), holder->record().offset());
+                    }
+                    _prefetched_messages.fetch_add(1);
+                    _prefetched_bytes.fetch_add(msg.payload().size());
+                    dispatch(std::move(msg));
+                    ++received;
                 } else {
                     // Log message
                 }
             }
-            on_message_received();
+            on_message_received(received);
+            notify_readable();
+            if (_handler) { schedule_handlers(); }
         }
     }
 
-    void KafkaConsumer::wait_for_new_messages(std::chrono::milliseconds timeout) {
+    void KafkaConsumer::dispatch(Message msg) {
+        if (_lanes.empty()) {
+            _messages.emplace(std::move(msg));
+            return;
+        }
+
+        std::size_t lane = static_cast<std::size_t>(msg.delivery_metadata()->partition());
+        if (_consumer_options.lane_routing() == KafkaLaneRouting::KEY && msg.key()) { lane = fnv1a_hash(*msg.key()); }
+        {
+            std::lock_guard<std::mutex> lck(_lanes_mtx);
+            ++_lane_messages;
+        }
+        _lanes[lane % _lanes.size()]->push(std::move(msg));
+    }
+
+    void KafkaConsumer::work_loop(tbb::concurrent_bounded_queue<Message>& lane, const MessageHandler& handler) {
+        Message msg;
+        while (true) {
+            lane.pop(msg);
+            if (_interrupted || !msg.delivery_metadata()) { return; }
+            on_message_dequeued(msg);
+            handle_message(msg, handler);
+
+            std::lock_guard<std::mutex> lck(_lanes_mtx);
+            if (--_lane_messages == 0) { _lanes_cv.notify_all(); }
+        }
+    }
+
+    void KafkaConsumer::handle_message(const Message& msg, const MessageHandler& handler) {
+        try {
+            handler(msg);
+        } catch (const std::exception& e) {
+            _logger->error("Failed to handle message {}: {}", msg.delivery_metadata()->to_string(), e.what());
+        }
+        try {
+            ack(msg);
+        } catch (const AckFailedError& e) {
+            // Already logged by ack
+        }
+    }
+
+    void KafkaConsumer::schedule_handlers() {
+        while (!_interrupted && !_messages.empty()) {
+            std::size_t running = _running_handlers.load();
+            if (running >= _handler_concurrency) { return; }
+            if (_running_handlers.compare_exchange_weak(running, running + 1)) {
+                {
+                    // Rechecked under lock so that stop() either waits for this task or prevents it from being enqueued
+                    std::lock_guard<std::mutex> lck(_handlers_mtx);
+                    if (_interrupted) {
+                        _running_handlers.fetch_sub(1);
+                        return;
+                    }
+                    ++_handler_tasks;
+                }
+                _handlers_arena->enqueue([this] { run_handlers(); });
+            }
+        }
+    }
+
+    void KafkaConsumer::run_handlers() {
+        ScopedThreadRole role(this, HANDLER_ROLE);
+        Message msg;
+        for (std::size_t handled = 0; handled < HANDLER_TASK_BATCH && !_interrupted && _messages.try_pop(msg); ++handled) {
+            on_message_dequeued(msg);
+            handle_message(msg, _handler);
+        }
+        on_message_consumed();
+
+        // Messages that arrive after slot is released are seen either by this recheck or by consume loop
+        _running_handlers.fetch_sub(1);
+        schedule_handlers();
+
+        std::lock_guard<std::mutex> lck(_handlers_mtx);
+        --_handler_tasks;
+        _handlers_cv.notify_all();
+    }
+
+    // Lanes routed by key interleave messages of one partition and concurrent handlers finish in any order, so their acks arrive out of order
+    bool KafkaConsumer::tracks_acked_offsets() const {
+        return _consumer_options.out_of_order_acks() || (!_lanes.empty() && _consumer_options.lane_routing() == KafkaLaneRouting::KEY) ||
+               _handler_concurrency > 1;
+    }
+
+    std::chrono::milliseconds KafkaConsumer::consume_poll_timeout() const {
+        std::chrono::milliseconds timeout = _fetch_paused ? PAUSED_POLL_TIMEOUT : CONSUME_POLL_TIMEOUT;
+        if (_consumer_options.ack_mode() == KafkaAckMode::COALESCED) { timeout = std::min(timeout, _consumer_options.commit_interval()); }
+        return timeout;
+    }
+
+    // Rebalance callbacks are invoked by librdkafka from inside poll, so they run on consume loop thread
+    void KafkaConsumer::on_rebalance(kafka::clients::consumer::RebalanceEventType event, const kafka::TopicPartitions& partitions) {
+        if (event == kafka::clients::consumer::RebalanceEventType::PartitionsAssigned) {
+            {
+                std::lock_guard<std::mutex> lck(_commit_mtx);
+                for (const kafka::TopicPartition& partition : partitions) {
+                    _assigned_partitions.insert(partition.second);
+                }
+            }
+            // Newly assigned partitions start fetching, so they are paused to match the rest of assignment
+            if (_fetch_paused && !partitions.empty()) { _consumer->pause(partitions); }
+            return;
+        }
+
+        // Workers finish messages already routed to lanes, so their acks are committed before partitions are handed over
+        {
+            std::unique_lock<std::mutex> lck(_lanes_mtx);
+            _lanes_cv.wait(lck, [&] { return _lane_messages == 0 || _interrupted; });
+        }
+        commit_pending_sync();
+
+        // Messages of revoked partitions may still be acked later, their offsets belong to the next owner now
+        std::lock_guard<std::mutex> sync_lck(_sync_commit_mtx);
+        std::lock_guard<std::mutex> lck(_commit_mtx);
+        for (const kafka::TopicPartition& partition : partitions) {
+            _assigned_partitions.erase(partition.second);
+            _committed_offsets.erase(partition.second);
+            _pending_commits.reset(partition.second);
+            _offset_tracker.reset(partition.second);
+        }
+    }
+
+    kafka::TopicPartitions KafkaConsumer::assigned_topic_partitions() const {
+        std::lock_guard<std::mutex> lck(_commit_mtx);
+        kafka::TopicPartitions result;
+        for (std::int32_t partition : _assigned_partitions) {
+            result.emplace(*_topic, partition);
+        }
+        return result;
+    }
+
+    bool KafkaConsumer::owns_partition(std::int32_t partition) const {
+        std::lock_guard<std::mutex> lck(_commit_mtx);
+        return _assigned_partitions.contains(partition);
+    }
+
+    void KafkaConsumer::maybe_commit_async() {
+        {
+            std::lock_guard<std::mutex> lck(_commit_mtx);
+            if (_pending_commits.empty()) { return; }
+            if (_pending_acks < _consumer_options.commit_batch_size() &&
+                std::chrono::steady_clock::now() - _last_commit_time < _consumer_options.commit_interval()) {
+                return;
+            }
+        }
+
+        // Empty offsets would make kafka consumer commit its current positions
+        kafka::TopicPartitionOffsets offsets = take_pending_commits();
+        if (offsets.empty()) { return; }
+
+        auto started_at = std::chrono::steady_clock::now();
+        try {
+            _consumer->commitAsync(offsets, [this, started_at](const kafka::TopicPartitionOffsets& committed, const kafka::Error& error) {
+                on_commit_completed(committed, error ? std::make_optional(error.message()) : std::nullopt, true, started_at);
+            });
+        } catch (const std::exception& e) { on_commit_completed(offsets, e.what(), true, started_at); }
+    }
+
+    void KafkaConsumer::commit_pending_sync() {
+        kafka::TopicPartitionOffsets offsets = take_pending_commits();
+        if (offsets.empty()) { return; }
+
+        auto started_at = std::chrono::steady_clock::now();
+        try {
+            _consumer->commitSync(offsets);
+            on_commit_completed(offsets, std::nullopt, false, started_at);
+        } catch (const std::exception& e) { on_commit_completed(offsets, e.what(), false, started_at); }
+    }
+
+    kafka::TopicPartitionOffsets KafkaConsumer::take_pending_commits() {
+        std::lock_guard<std::mutex> lck(_commit_mtx);
+        kafka::TopicPartitionOffsets offsets;
+        for (const auto& [partition, offset] : _pending_commits.take()) {
+            offsets.emplace(kafka::TopicPartition(*_topic, partition), offset);
+        }
+        _pending_acks     = 0;
+        _last_commit_time = std::chrono::steady_clock::now();
+        return offsets;
+    }
+
+    void KafkaConsumer::on_commit_completed(const kafka::TopicPartitionOffsets& offsets, std::optional<std::string> error, bool retry,
+                                            std::chrono::steady_clock::time_point started_at) {
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started_at);
+
+        std::lock_guard<std::mutex> lck(_commit_mtx);
+        ++_commits;
+        _total_commit_latency += latency;
+        _max_commit_latency  = std::max(_max_commit_latency, latency);
+        _last_commit_latency = latency;
+        if (!error) {
+            for (const auto& [partition, offset] : offsets) {
+                _pending_commits.on_committed(partition.second, offset);
+            }
+            return;
+        }
+
+        ++_commit_failures;
+        _logger->error("Failed to commit offsets {}: {}", offsets_to_string(offsets), *error);
+        if (!retry) { return; }
+
+        // Failed offsets are retried with the next commit unless superseded by a newer commit.
+        // Partitions that were revoked meanwhile are skipped, as their commits would fail forever
+        for (const auto& [partition, offset] : offsets) {
+            if (!_assigned_partitions.contains(partition.second)) { continue; }
+            _pending_commits.on_failed(partition.second, offset);
+        }
+    }
+
+    // Applies pause flag and prefetch backpressure between polls, kafka consumer is only paused and resumed on consume loop thread
+    void KafkaConsumer::update_fetch_state() {
+        if (_backpressured) {
+            if (prefetch_below_low_watermark()) { _backpressured = false; }
+        } else if (prefetch_reached_high_watermark()) {
+            _logger->debug("Prefetch high watermark is reached ({} messages, {} bytes) - fetching is paused", _prefetched_messages.load(),
+                           _prefetched_bytes.load());
+            _backpressured = true;
+        }
+
+        bool should_pause = _paused || _backpressured;
+        if (should_pause != _fetch_paused) {
+            kafka::TopicPartitions partitions = assigned_topic_partitions();
+            if (!partitions.empty()) {
+                if (should_pause) {
+                    _consumer->pause(partitions);
+                } else {
+                    _consumer->resume(partitions);
+                }
+            }
+            _fetch_paused = should_pause;
+        }
+    }
+
+    bool KafkaConsumer::prefetch_reached_high_watermark() const {
+        auto max_messages = _consumer_options.prefetch_high_watermark_messages();
+        auto max_bytes    = _consumer_options.prefetch_high_watermark_bytes();
+        return (max_messages && _prefetched_messages >= *max_messages) || (max_bytes && _prefetched_bytes >= *max_bytes);
+    }
+
+    bool KafkaConsumer::prefetch_below_low_watermark() const {
+        auto low_watermark = [](std::optional<std::size_t> high, std::optional<std::size_t> low) {
+            return std::min(low.value_or(*high / 2), *high);
+        };
+
+        auto max_messages = _consumer_options.prefetch_high_watermark_messages();
+        auto max_bytes    = _consumer_options.prefetch_high_watermark_bytes();
+        return (!max_messages || _prefetched_messages <= low_watermark(max_messages, _consumer_options.prefetch_low_watermark_messages())) &&
+               (!max_bytes || _prefetched_bytes <= low_watermark(max_bytes, _consumer_options.prefetch_low_watermark_bytes()));
+    }
+
+    void KafkaConsumer::start_consume_loop() {
         if (!_started) {
             bool expected_started = false;
             if (_started.compare_exchange_strong(expected_started, true)) {
                 _work_ftr = std::async(std::launch::async, std::bind(&KafkaConsumer::consume_loop, this));
             }
         }
+    }
+
+    void KafkaConsumer::wait_for_new_messages(std::chrono::milliseconds timeout) {
+        start_consume_loop();
+        if (_consumer_options.wakeup_mode() == KafkaWakeupMode::SPIN_THEN_PARK) {
+            if (!_poll_notifier.wait_for([&] { return !_messages.empty() || _interrupted; }, timeout)) { throw TimeoutError(); }
+            return;
+        }
         std::unique_lock<std::mutex> lck(_poll_mtx);
-        if (!_poll_cv.wait_for(lck, timeout, [&] { return !_messages.empty(); })) { throw TimeoutError(); }
+        if (!_poll_cv.wait_for(lck, timeout, [&] { return !_messages.empty() || _interrupted; })) { throw TimeoutError(); }
+    }
+
+    // Callbacks are invoked without lock held, so they may register new ones
+    void KafkaConsumer::notify_readable() {
+        std::map<std::uint64_t, std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lck(_readable_mtx);
+            if (_readable_callbacks.empty() || (_messages.empty() && !_interrupted)) { return; }
+            callbacks.swap(_readable_callbacks);
+        }
+        for (auto& [id, callback] : callbacks) {
+            callback();
+        }
     }
 
-    void KafkaConsumer::on_message_received() {
-        _poll_cv.notify_all();
+    void KafkaConsumer::on_message_received(std::size_t count) {
+        if (_consumer_options.wakeup_mode() == KafkaWakeupMode::SPIN_THEN_PARK) {
+            _poll_notifier.notify(count);
+        } else {
+            _poll_cv.notify_all();
+        }
+    }
+
+    void KafkaConsumer::on_message_dequeued(const Message& msg) {
+        _prefetched_messages.fetch_sub(1);
+        _prefetched_bytes.fetch_sub(msg.payload().size());
+        if (const auto& received_at = msg.delivery_metadata()->received_at()) {
+            auto latency = std::chrono::steady_clock::now() - *received_at;
+            _enqueue_to_dequeue_latency.record(std::chrono::duration_cast<std::chrono::microseconds>(latency));
+        }
     }
 
     void KafkaConsumer::on_message_consumed() {
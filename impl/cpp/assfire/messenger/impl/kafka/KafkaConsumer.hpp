@@ -1,7 +1,15 @@
 #pragma once
 
+#include "KafkaCommitStats.hpp"
 #include "KafkaConsumerOptions.hpp"
+#include "KafkaLatencyStats.hpp"
+#include "KafkaMetrics.hpp"
+#include "KafkaOffsetTracker.hpp"
+#include "KafkaPendingCommits.hpp"
 #include "assfire/messenger/api/Consumer.hpp"
+#include "assfire/messenger/impl/util/BufferPool.hpp"
+#include "assfire/messenger/impl/util/LatencyHistogram.hpp"
+#include "assfire/messenger/impl/util/WakeupNotifier.hpp"
 #include "assfire/logger/api/Logger.hpp"
 
 #include <atomic>
@@ -9,41 +17,136 @@
 #include <functional>
 #include <future>
 #include <kafka/KafkaConsumer.h>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <oneapi/tbb/concurrent_queue.h>
+#include <oneapi/tbb/task_arena.h>
+#include <thread>
+#include <vector>
 
 namespace assfire::messenger {
     class KafkaConsumer : public Consumer {
       public:
         ~KafkaConsumer();
 
-        KafkaConsumer(std::shared_ptr<kafka::clients::KafkaConsumer> consumer, KafkaConsumerOptions options);
+        KafkaConsumer(std::shared_ptr<kafka::clients::KafkaConsumer> consumer, KafkaConsumerOptions options,
+                      std::shared_ptr<tbb::task_arena> handlers_arena = nullptr);
         virtual Message poll() override;
         virtual Message poll(std::chrono::milliseconds timeout) override;
+        virtual void poll_into(Message& msg) override;
+        virtual void poll_into(Message& msg, std::chrono::milliseconds timeout) override;
+        virtual std::size_t poll_batch(std::vector<Message>& messages, std::size_t max_messages, std::chrono::milliseconds timeout) override;
         virtual void ack(const Message& msg) override;
         virtual void pause() override;
         virtual void resume() override;
         virtual void stop() override;
         virtual void drain() override;
+        virtual void subscribe(MessageHandler handler, std::size_t concurrency) override;
+        virtual std::size_t try_poll_batch(std::vector<Message>& messages, std::size_t max_messages) override;
+        virtual std::uint64_t notify_when_readable(std::function<void()> callback) override;
+        virtual bool cancel_readable_notification(std::uint64_t id) override;
+        virtual bool stopped() const override;
+
+        // Subscribes kafka consumer to configured topic with rebalance listener bound to this consumer
+        void subscribe_topic();
+
+        // Switches consumer to parallel mode: received messages are routed to worker_count lanes instead of poll queue.
+        // Each lane is served by its own thread which calls handler and then acks the message.
+        // Handler exceptions are logged and the message is acked anyway, so handler should deal with its own failures
+        void start_workers(MessageHandler handler);
 
         const KafkaConsumerOptions& options();
+        KafkaCommitStats commit_stats() const;
+        KafkaLatencyStats latency_stats() const;
+        // Latest librdkafka statistics, empty until statistics interval is configured and first statistics are emitted
+        std::optional<KafkaMetrics> metrics() const;
 
       private:
-        void on_message_received();
+        void on_message_received(std::size_t count);
+        void notify_readable();
+        void on_message_dequeued(const Message& msg);
         void on_message_consumed();
         void wait_for_new_messages(std::chrono::milliseconds timeout);
+        void wake_waiters();
+        void interrupt_consume_poll();
+        void start_consume_loop();
         void consume_loop();
+        void dispatch(Message msg);
+        void work_loop(tbb::concurrent_bounded_queue<Message>& lane, const MessageHandler& handler);
+        void handle_message(const Message& msg, const MessageHandler& handler);
+        void schedule_handlers();
+        void run_handlers();
+        bool tracks_acked_offsets() const;
+        void update_fetch_state();
+        bool prefetch_reached_high_watermark() const;
+        bool prefetch_below_low_watermark() const;
+        std::chrono::milliseconds consume_poll_timeout() const;
+        void on_rebalance(kafka::clients::consumer::RebalanceEventType event, const kafka::TopicPartitions& partitions);
+        bool owns_partition(std::int32_t partition) const;
+        kafka::TopicPartitions assigned_topic_partitions() const;
+        void maybe_commit_async();
+        void commit_pending_sync();
+        kafka::TopicPartitionOffsets take_pending_commits();
+        void on_commit_completed(const kafka::TopicPartitionOffsets& offsets, std::optional<std::string> error, bool retry,
+                                 std::chrono::steady_clock::time_point started_at);
 
         std::shared_ptr<kafka::clients::KafkaConsumer> _consumer;
+        std::shared_ptr<const std::string> _topic;
+        // Received records are allocated from the pool, so their storage is reused once messages referring to them are released
+        std::shared_ptr<BufferPool> _record_pool;
         std::mutex _poll_mtx;
         std::mutex _drain_mtx;
         std::condition_variable _poll_cv;
         std::condition_variable _drain_cv;
+        WakeupNotifier _poll_notifier;
         std::future<void> _work_ftr;
         tbb::concurrent_queue<Message> _messages;
+        std::vector<std::unique_ptr<tbb::concurrent_bounded_queue<Message>>> _lanes;
+        std::vector<std::thread> _workers;
+        // Messages pushed to lanes and not yet handled, revocation waits for them so their acks are committed by this owner
+        std::size_t _lane_messages = 0;
+        std::mutex _lanes_mtx;
+        std::condition_variable _lanes_cv;
+        std::shared_ptr<tbb::task_arena> _handlers_arena;
+        MessageHandler _handler;
+        std::size_t _handler_concurrency = 0;
+        // Running handlers hold concurrency slots, handler tasks are counted until they stop touching the consumer
+        std::atomic<std::size_t> _running_handlers;
+        std::size_t _handler_tasks = 0;
+        std::mutex _handlers_mtx;
+        std::condition_variable _handlers_cv;
+        std::mutex _readable_mtx;
+        std::map<std::uint64_t, std::function<void()>> _readable_callbacks;
+        std::uint64_t _next_readable_callback_id = 0;
         std::atomic_bool _interrupted;
         std::atomic_bool _started;
+        std::atomic_bool _paused;
+        std::atomic<std::size_t> _prefetched_messages;
+        std::atomic<std::size_t> _prefetched_bytes;
+        // Fetch state is only touched by consume loop and rebalance callback invoked from its poll, pause/resume callers just set _paused
+        bool _backpressured = false;
+        bool _fetch_paused  = false;
+        mutable std::mutex _commit_mtx;
+        KafkaPendingCommits _pending_commits;
+        // Acks of messages from partitions that are not assigned anymore are dropped, the next owner redelivers them
+        std::set<std::int32_t> _assigned_partitions;
+        // Synchronous commits are issued one at a time, so offset committed by a late ack never moves back the one committed before it
+        std::mutex _sync_commit_mtx;
+        std::map<std::int32_t, std::int64_t> _committed_offsets;
+        std::size_t _pending_acks = 0;
+        std::chrono::steady_clock::time_point _last_commit_time;
+        KafkaOffsetTracker _offset_tracker;
+        std::uint64_t _commits         = 0;
+        std::uint64_t _commit_failures = 0;
+        std::chrono::microseconds _total_commit_latency {0};
+        std::chrono::microseconds _max_commit_latency {0};
+        std::chrono::microseconds _last_commit_latency {0};
+        KafkaStatisticsCollector _statistics;
+        LatencyHistogram _broker_to_enqueue_latency;
+        LatencyHistogram _enqueue_to_dequeue_latency;
         KafkaConsumerOptions _consumer_options;
         std::shared_ptr<logger::Logger> _logger;
     };
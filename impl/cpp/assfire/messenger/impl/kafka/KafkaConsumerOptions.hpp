@@ -4,11 +4,27 @@
 #include "kafka/ConsumerConfig.h"
 
 #include <absl/strings/str_join.h>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <unordered_set>
 
 namespace assfire::messenger {
+    // SYNC commits offset of every acked message before ack returns.
+    // COALESCED keeps highest acked offset per partition and commits them asynchronously from consume loop
+    // once commit interval elapses or commit batch size is acked, with final synchronous commit on stop and partition revocation
+    enum class KafkaAckMode { SYNC, COALESCED };
+
+    // CONDITION_VARIABLE wakes all waiting pollers through mutex and condition variable whenever messages arrive.
+    // SPIN_THEN_PARK makes pollers spin briefly and then park on a futex, waking only as many of them as messages arrived
+    enum class KafkaWakeupMode { CONDITION_VARIABLE, SPIN_THEN_PARK };
+
+    // Defines how messages are distributed between worker lanes of KafkaConsumer::start_workers. Messages of one lane are
+    // handled sequentially, so PARTITION keeps per-partition order and KEY keeps per-key order while spreading one partition over lanes
+    enum class KafkaLaneRouting { PARTITION, KEY };
+
     class KafkaConsumerOptions {
       public:
         KafkaConsumerOptions()                                = default;
@@ -35,6 +51,7 @@ namespace assfire::messenger {
             tokens.push_back(_isolation_level.to_string());
             tokens.push_back(_partition_assignment_strategy.to_string());
             tokens.push_back(_security_protocol.to_string());
+            tokens.push_back(_statistics_interval_ms.to_string());
             std::erase_if(tokens, [](const auto &s) { return s.empty(); });
             return "{" + absl::StrJoin(tokens, ",") + "}";
         }
@@ -54,6 +71,7 @@ namespace assfire::messenger {
             _isolation_level.fill_config(result);
             _partition_assignment_strategy.fill_config(result);
             _security_protocol.fill_config(result);
+            _statistics_interval_ms.fill_config(result);
             return result;
         }
 
@@ -148,6 +166,13 @@ namespace assfire::messenger {
             _security_protocol = security_protocol;
         }
 
+        KafkaOptions::StatisticsIntervalMs statistics_interval_ms() const {
+            return _statistics_interval_ms;
+        }
+        void set_statistics_interval_ms(const KafkaOptions::StatisticsIntervalMs &statistics_interval_ms) {
+            _statistics_interval_ms = statistics_interval_ms;
+        }
+
         std::string topic_name() const {
             return _topic_name;
         }
@@ -162,6 +187,95 @@ namespace assfire::messenger {
             _partitions = partitions;
         }
 
+        // Fetching is paused when either of high watermarks is reached by prefetched messages which weren't polled yet,
+        // and resumed when prefetched messages fall to both low watermarks (half of high ones when unset)
+        std::optional<std::size_t> prefetch_high_watermark_messages() const {
+            return _prefetch_high_watermark_messages;
+        }
+        void set_prefetch_high_watermark_messages(std::optional<std::size_t> prefetch_high_watermark_messages) {
+            _prefetch_high_watermark_messages = prefetch_high_watermark_messages;
+        }
+
+        std::optional<std::size_t> prefetch_low_watermark_messages() const {
+            return _prefetch_low_watermark_messages;
+        }
+        void set_prefetch_low_watermark_messages(std::optional<std::size_t> prefetch_low_watermark_messages) {
+            _prefetch_low_watermark_messages = prefetch_low_watermark_messages;
+        }
+
+        std::optional<std::size_t> prefetch_high_watermark_bytes() const {
+            return _prefetch_high_watermark_bytes;
+        }
+        void set_prefetch_high_watermark_bytes(std::optional<std::size_t> prefetch_high_watermark_bytes) {
+            _prefetch_high_watermark_bytes = prefetch_high_watermark_bytes;
+        }
+
+        KafkaAckMode ack_mode() const {
+            return _ack_mode;
+        }
+        void set_ack_mode(KafkaAckMode ack_mode) {
+            _ack_mode = ack_mode;
+        }
+
+        std::chrono::milliseconds commit_interval() const {
+            return _commit_interval;
+        }
+        void set_commit_interval(std::chrono::milliseconds commit_interval) {
+            _commit_interval = commit_interval;
+        }
+
+        std::size_t commit_batch_size() const {
+            return _commit_batch_size;
+        }
+        void set_commit_batch_size(std::size_t commit_batch_size) {
+            _commit_batch_size = commit_batch_size;
+        }
+
+        // When enabled, ack of a message commits only contiguous prefix of acked offsets of its partition,
+        // so messages may be acked in any order without skipping unprocessed ones
+        bool out_of_order_acks() const {
+            return _out_of_order_acks;
+        }
+        void set_out_of_order_acks(bool out_of_order_acks) {
+            _out_of_order_acks = out_of_order_acks;
+        }
+
+        KafkaWakeupMode wakeup_mode() const {
+            return _wakeup_mode;
+        }
+        void set_wakeup_mode(KafkaWakeupMode wakeup_mode) {
+            _wakeup_mode = wakeup_mode;
+        }
+
+        std::size_t worker_count() const {
+            return _worker_count;
+        }
+        void set_worker_count(std::size_t worker_count) {
+            _worker_count = worker_count;
+        }
+
+        KafkaLaneRouting lane_routing() const {
+            return _lane_routing;
+        }
+        void set_lane_routing(KafkaLaneRouting lane_routing) {
+            _lane_routing = lane_routing;
+        }
+
+        std::optional<std::size_t> prefetch_low_watermark_bytes() const {
+            return _prefetch_low_watermark_bytes;
+        }
+        void set_prefetch_low_watermark_bytes(std::optional<std::size_t> prefetch_low_watermark_bytes) {
+            _prefetch_low_watermark_bytes = prefetch_low_watermark_bytes;
+        }
+
+        // Maximum number of released received records whose storage is kept for reuse by following ones
+        std::size_t record_pool_size() const {
+            return _record_pool_size;
+        }
+        void set_record_pool_size(std::size_t record_pool_size) {
+            _record_pool_size = record_pool_size;
+        }
+
       private:
         KafkaOptions::BootstrapServers _bootstrap_servers;
         KafkaOptions::GroupId _group_id;
@@ -176,8 +290,21 @@ namespace assfire::messenger {
         KafkaOptions::IsolationLevel _isolation_level;
         KafkaOptions::PartitionAssignmentStrategy _partition_assignment_strategy;
         KafkaOptions::SecurityProtocol _security_protocol;
+        KafkaOptions::StatisticsIntervalMs _statistics_interval_ms;
 
         std::string _topic_name;
         std::unordered_set<std::uint32_t> _partitions;
+        std::optional<std::size_t> _prefetch_high_watermark_messages;
+        std::optional<std::size_t> _prefetch_low_watermark_messages;
+        std::optional<std::size_t> _prefetch_high_watermark_bytes;
+        std::optional<std::size_t> _prefetch_low_watermark_bytes;
+        KafkaAckMode _ack_mode                     = KafkaAckMode::SYNC;
+        std::chrono::milliseconds _commit_interval = std::chrono::seconds(1);
+        std::size_t _commit_batch_size             = 1000;
+        bool _out_of_order_acks                    = false;
+        KafkaWakeupMode _wakeup_mode               = KafkaWakeupMode::CONDITION_VARIABLE;
+        std::size_t _worker_count                  = 1;
+        KafkaLaneRouting _lane_routing             = KafkaLaneRouting::PARTITION;
+        std::size_t _record_pool_size              = 1024;
     };
 } // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "assfire/messenger/impl/util/LatencyHistogram.hpp"
+
+namespace assfire::messenger {
+    // Latencies of messages received by a consumer. Broker to enqueue latency is measured from record timestamp assigned by
+    // producer or broker to the moment consume loop queues the message, so it includes clock skew between hosts.
+    // Enqueue to dequeue latency is measured with local monotonic clock until message is polled or taken by a handler
+    class KafkaLatencyStats {
+      public:
+        KafkaLatencyStats() = default;
+        KafkaLatencyStats(LatencySnapshot broker_to_enqueue, LatencySnapshot enqueue_to_dequeue)
+            : _broker_to_enqueue(std::move(broker_to_enqueue)),
+              _enqueue_to_dequeue(std::move(enqueue_to_dequeue)) {}
+        KafkaLatencyStats(const KafkaLatencyStats& rhs) = default;
+        KafkaLatencyStats(KafkaLatencyStats&& rhs)      = default;
+
+        KafkaLatencyStats& operator=(const KafkaLatencyStats& rhs) = default;
+        KafkaLatencyStats& operator=(KafkaLatencyStats&& rhs) = default;
+
+        const LatencySnapshot& broker_to_enqueue() const {
+            return _broker_to_enqueue;
+        }
+
+        const LatencySnapshot& enqueue_to_dequeue() const {
+            return _enqueue_to_dequeue;
+        }
+
+      private:
+        LatencySnapshot _broker_to_enqueue;
+        LatencySnapshot _enqueue_to_dequeue;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
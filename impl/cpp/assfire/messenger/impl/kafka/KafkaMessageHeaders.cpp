@@ -18,4 +18,14 @@ namespace assfire::messenger {
         return std::stol(value);
     }
 
+    std::vector<Header> encode_kafka_headers(const DeliveryMetadata& metadata) {
+        // Names are known in advance, so they are interned once
+        static const HeaderId offset_id(KAFKA_HEADER_OFFSET);
+        static const HeaderId topic_name_id(KAFKA_HEADER_TOPIC_NAME);
+        static const HeaderId topic_partition_id(KAFKA_HEADER_TOPIC_PARTITION);
+
+        return {Header(offset_id, encode_offset_header(metadata.offset())), Header(topic_name_id, metadata.topic()),
+                Header(topic_partition_id, encode_partition_header(metadata.partition()))};
+    }
+
 } // namespace assfire::messenger
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <string>
+#include "assfire/messenger/api/DeliveryMetadata.hpp"
+#include "assfire/messenger/api/Header.hpp"
+
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace assfire::messenger {
     constexpr const char* KAFKA_HEADER_OFFSET          = "KAFKA_HEADER_OFFSET";
@@ -13,4 +17,7 @@ namespace assfire::messenger {
 
     std::string encode_partition_header(int32_t partition);
     int32_t decode_partition_header(const std::string& value);
+
+    // Renders delivery metadata of received message as string headers, intended for debugging only
+    std::vector<Header> encode_kafka_headers(const DeliveryMetadata& metadata);
 } // namespace assfire::messenger
\ No newline at end of file
@@ -1,16 +1,18 @@
 #include "KafkaMessenger.hpp"
 
 #include "KafkaConsumer.hpp"
-#include "KafkaExceptions.hpp"
 #include "assfire/logger/api/LoggerProvider.hpp"
 #include "assfire/messenger/api/Exceptions.hpp"
 #include "kafka/KafkaConsumer.h"
 
 #include <memory>
+#include <vector>
 
 namespace assfire::messenger {
 
-    KafkaMessenger::KafkaMessenger() : _logger(logger::LoggerProvider::get("assfire.messenger.KafkaMessenger")) {}
+    KafkaMessenger::KafkaMessenger()
+        : _handlers_arena(std::make_shared<tbb::task_arena>()),
+          _logger(logger::LoggerProvider::get("assfire.messenger.KafkaMessenger")) {}
 
     std::shared_ptr<Publisher> KafkaMessenger::get_publisher(const ChannelId& channel_id) {
         tbb::concurrent_hash_map<ChannelId, std::shared_ptr<KafkaPublisher>>::const_accessor accessor;
@@ -43,13 +45,18 @@ namespace assfire::messenger {
             kafka::clients::consumer::Config props = options.to_kafka_config();
 
             tbb::concurrent_hash_map<ChannelId, std::shared_ptr<KafkaConsumer>>::accessor write_accessor;
-            bool is_new = _consumers.insert(write_accessor, channel_id);
+            bool is_new = false;
+            {
+                std::shared_lock<std::shared_mutex> lck(_channels_mtx);
+                is_new = _consumers.insert(write_accessor, channel_id);
+            }
 
             if (is_new) {
                 auto kafka_consumer = std::make_shared<kafka::clients::KafkaConsumer>(props);
-                kafka_consumer->subscribe({options.topic_name()});
+                auto consumer       = std::make_shared<KafkaConsumer>(std::move(kafka_consumer), std::move(options), _handlers_arena);
+                consumer->subscribe_topic();
 
-                write_accessor->second = std::make_shared<KafkaConsumer>(std::move(kafka_consumer), std::move(options));
+                write_accessor->second = std::move(consumer);
             } else {
                 if (write_accessor->second->options() != options) {
                     _logger->error("Trying to redeclare existing consumer channel {} (options = {}) with different options {} - this is not allowed",
@@ -70,13 +77,15 @@ namespace assfire::messenger {
         try {
             _logger->info("Creating kafka publisher channel {} (options: {})", channel_id.name(), options.to_string());
 
-            kafka::clients::producer::Config props = options.to_kafka_config();
-
             tbb::concurrent_hash_map<ChannelId, std::shared_ptr<KafkaPublisher>>::accessor write_accessor;
-            bool is_new = _publishers.insert(write_accessor, channel_id);
+            bool is_new = false;
+            {
+                std::shared_lock<std::shared_mutex> lck(_channels_mtx);
+                is_new = _publishers.insert(write_accessor, channel_id);
+            }
 
             if (is_new) {
-                write_accessor->second = std::make_shared<KafkaPublisher>(std::make_shared<kafka::clients::KafkaProducer>(props), std::move(options));
+                write_accessor->second = std::make_shared<KafkaPublisher>(std::move(options));
             } else {
                 if (write_accessor->second->options() != options) {
                     _logger->error("Trying to redeclare existing publisher channel {} (options = {}) with different options {} - this is not allowed",
@@ -94,11 +103,41 @@ namespace assfire::messenger {
     }
 
     void KafkaMessenger::destroy_consumer(ChannelId channel_id) {
+        std::shared_lock<std::shared_mutex> lck(_channels_mtx);
         _consumers.erase(channel_id);
     }
 
     void KafkaMessenger::destroy_publisher(ChannelId channel_id) {
+        std::shared_lock<std::shared_mutex> lck(_channels_mtx);
         _publishers.erase(channel_id);
     }
 
+    // Channel ids are snapshotted under lock, channels are then looked up one by one, waiting for ones being created
+    KafkaMessengerMetrics KafkaMessenger::metrics() const {
+        std::vector<ChannelId> consumer_ids;
+        std::vector<ChannelId> publisher_ids;
+        {
+            std::unique_lock<std::shared_mutex> lck(_channels_mtx);
+            for (const auto& [channel_id, consumer] : _consumers) {
+                consumer_ids.push_back(channel_id);
+            }
+            for (const auto& [channel_id, publisher] : _publishers) {
+                publisher_ids.push_back(channel_id);
+            }
+        }
+
+        KafkaMessengerMetrics result;
+        for (const ChannelId& channel_id : consumer_ids) {
+            tbb::concurrent_hash_map<ChannelId, std::shared_ptr<KafkaConsumer>>::const_accessor accessor;
+            if (!_consumers.find(accessor, channel_id) || !accessor->second) { continue; }
+            if (auto metrics = accessor->second->metrics()) { result.consumers.emplace(channel_id.name(), std::move(*metrics)); }
+        }
+        for (const ChannelId& channel_id : publisher_ids) {
+            tbb::concurrent_hash_map<ChannelId, std::shared_ptr<KafkaPublisher>>::const_accessor accessor;
+            if (!_publishers.find(accessor, channel_id) || !accessor->second) { continue; }
+            if (auto metrics = accessor->second->metrics()) { result.publishers.emplace(channel_id.name(), std::move(*metrics)); }
+        }
+        return result;
+    }
+
 } // namespace assfire::messenger
\ No newline at end of file
@@ -2,12 +2,15 @@
 
 #include "KafkaConsumer.hpp"
 #include "KafkaConsumerOptions.hpp"
+#include "KafkaMetrics.hpp"
 #include "KafkaPublisher.hpp"
 #include "assfire/logger/api/Logger.hpp"
 #include "assfire/messenger/api/Messenger.hpp"
 
 #include <memory>
 #include <oneapi/tbb/concurrent_hash_map.h>
+#include <oneapi/tbb/task_arena.h>
+#include <shared_mutex>
 #include <string>
 
 namespace assfire::messenger {
@@ -24,9 +27,16 @@ namespace assfire::messenger {
         void destroy_consumer(ChannelId channel_id);
         void destroy_publisher(ChannelId channel_id);
 
+        // Latest statistics of all channels which have them
+        KafkaMessengerMetrics metrics() const;
+
       private:
+        // Subscription handlers of all consumers share this arena, so idle channels don't occupy threads
+        std::shared_ptr<tbb::task_arena> _handlers_arena;
         tbb::concurrent_hash_map<ChannelId, std::shared_ptr<KafkaConsumer>> _consumers;
         tbb::concurrent_hash_map<ChannelId, std::shared_ptr<KafkaPublisher>> _publishers;
+        // Channel maps can't be traversed concurrently with insertion or erasure, so those hold it shared and traversal holds it exclusively
+        mutable std::shared_mutex _channels_mtx;
         std::shared_ptr<logger::Logger> _logger;
     };
 } // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "KafkaMetrics.hpp"
+
+#include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/impl/util/JsonValue.hpp"
+
+#include <stdexcept>
+
+namespace assfire::messenger {
+
+    namespace {
+        std::int64_t int_member(const JsonValue& json, std::string_view name, std::int64_t fallback = 0) {
+            const JsonValue* value = json.find(name);
+            return value ? value->as_int(fallback) : fallback;
+        }
+
+        std::chrono::microseconds rtt_member(const JsonValue& json, std::string_view name) {
+            const JsonValue* value = json.find_path({"rtt", name});
+            return std::chrono::microseconds(value ? value->as_int() : 0);
+        }
+
+        KafkaBrokerMetrics parse_broker(const JsonValue& json) {
+            KafkaBrokerMetrics result;
+            result.name               = json.find("name") ? json.find("name")->as_string() : "";
+            result.in_flight_requests = int_member(json, "waitresp_cnt");
+            result.queued_requests    = int_member(json, "outbuf_cnt");
+            result.rtt_avg            = rtt_member(json, "avg");
+            result.rtt_p50            = rtt_member(json, "p50");
+            result.rtt_p99            = rtt_member(json, "p99");
+            return result;
+        }
+
+        KafkaTopicMetrics parse_topic(const std::string& topic, const JsonValue& json) {
+            KafkaTopicMetrics result;
+            result.topic = topic;
+            if (const JsonValue* batch_size = json.find("batchsize")) {
+                result.batch_size_avg = batch_size->find("avg") ? batch_size->find("avg")->as_double() : 0;
+                result.batch_size_p99 = int_member(*batch_size, "p99");
+            }
+            if (const JsonValue* batch_messages = json.find("batchcnt")) {
+                result.batch_messages_avg = batch_messages->find("avg") ? batch_messages->find("avg")->as_double() : 0;
+                result.batch_messages_p99 = int_member(*batch_messages, "p99");
+            }
+            return result;
+        }
+
+        KafkaPartitionMetrics parse_partition(const std::string& topic, const JsonValue& json) {
+            KafkaPartitionMetrics result;
+            result.topic                = topic;
+            result.partition            = static_cast<std::int32_t>(int_member(json, "partition", -1));
+            result.queued_messages      = int_member(json, "msgq_cnt") + int_member(json, "xmit_msgq_cnt");
+            result.fetch_queue_messages = int_member(json, "fetchq_cnt");
+            result.committed_offset     = int_member(json, "committed_offset", -1);
+            result.high_watermark       = int_member(json, "hi_offset", -1);
+            result.consumer_lag         = int_member(json, "consumer_lag", -1);
+            return result;
+        }
+    } // namespace
+
+    std::int64_t KafkaMetrics::total_consumer_lag() const {
+        std::int64_t result = 0;
+        for (const auto& partition : partitions) {
+            if (partition.consumer_lag > 0) { result += partition.consumer_lag; }
+        }
+        return result;
+    }
+
+    std::int64_t KafkaMessengerMetrics::total_consumer_lag() const {
+        std::int64_t result = 0;
+        for (const auto& [channel, metrics] : consumers) {
+            result += metrics.total_consumer_lag();
+        }
+        return result;
+    }
+
+    std::int64_t KafkaMessengerMetrics::total_queued_messages() const {
+        std::int64_t result = 0;
+        for (const auto& [channel, metrics] : publishers) {
+            result += metrics.queued_messages;
+        }
+        return result;
+    }
+
+    KafkaMetrics parse_kafka_statistics(std::string_view json) {
+        JsonValue stats = JsonValue::parse(json);
+        if (!stats.is_object()) { throw std::invalid_argument("Kafka statistics must be a JSON object"); }
+
+        KafkaMetrics result;
+        result.client_name       = stats.find("name") ? stats.find("name")->as_string() : "";
+        result.collected_at      = std::chrono::system_clock::time_point(std::chrono::seconds(int_member(stats, "time")));
+        result.queued_messages   = int_member(stats, "msg_cnt");
+        result.queued_bytes      = int_member(stats, "msg_size");
+        result.sent_messages     = int_member(stats, "txmsgs");
+        result.sent_bytes        = int_member(stats, "txmsg_bytes");
+        result.received_messages = int_member(stats, "rxmsgs");
+        result.received_bytes    = int_member(stats, "rxmsg_bytes");
+
+        if (const JsonValue* brokers = stats.find("brokers")) {
+            for (const auto& [name, broker] : brokers->members()) {
+                result.brokers.push_back(parse_broker(broker));
+            }
+        }
+        if (const JsonValue* topics = stats.find("topics")) {
+            for (const auto& [topic, topic_stats] : topics->members()) {
+                result.topics.push_back(parse_topic(topic, topic_stats));
+                if (const JsonValue* partitions = topic_stats.find("partitions")) {
+                    for (const auto& [name, partition] : partitions->members()) {
+                        // Partition -1 is librdkafka's internal queue of not yet partitioned messages
+                        if (int_member(partition, "partition", -1) < 0) { continue; }
+                        result.partitions.push_back(parse_partition(topic, partition));
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    KafkaStatisticsCollector::KafkaStatisticsCollector() : _logger(logger::LoggerProvider::get("assfire.messenger.KafkaStatisticsCollector")) {}
+
+    void KafkaStatisticsCollector::on_statistics(const std::string& json) {
+        std::string raw_statistics = json;
+        std::lock_guard<std::mutex> lck(_mtx);
+        _raw_statistics.swap(raw_statistics);
+    }
+
+    std::optional<KafkaMetrics> KafkaStatisticsCollector::metrics() const {
+        std::lock_guard<std::mutex> lck(_mtx);
+        if (!_raw_statistics.empty()) {
+            try {
+                _metrics = parse_kafka_statistics(_raw_statistics);
+            } catch (const std::exception& e) { _logger->error("Failed to parse kafka statistics: {}", e.what()); }
+            _raw_statistics.clear();
+        }
+        return _metrics;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "assfire/logger/api/Logger.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace assfire::messenger {
+    // Snapshots of librdkafka statistics, see STATISTICS.md of librdkafka for meaning of source fields.
+    // Counters that librdkafka doesn't report for given client type (i.e. consumer lag for producer) are left zero
+
+    struct KafkaBrokerMetrics {
+        std::string name;
+        // Requests sent and awaiting response (waitresp_cnt)
+        std::int64_t in_flight_requests = 0;
+        // Requests waiting to be sent (outbuf_cnt)
+        std::int64_t queued_requests = 0;
+        std::chrono::microseconds rtt_avg {0};
+        std::chrono::microseconds rtt_p50 {0};
+        std::chrono::microseconds rtt_p99 {0};
+    };
+
+    struct KafkaTopicMetrics {
+        std::string topic;
+        // Size of produce batches in bytes (batchsize) and in messages (batchcnt)
+        double batch_size_avg              = 0;
+        std::int64_t batch_size_p99        = 0;
+        double batch_messages_avg          = 0;
+        std::int64_t batch_messages_p99    = 0;
+    };
+
+    struct KafkaPartitionMetrics {
+        std::string topic;
+        std::int32_t partition = 0;
+        // Messages waiting to be produced (msgq_cnt + xmit_msgq_cnt)
+        std::int64_t queued_messages = 0;
+        // Pre-fetched messages waiting to be consumed (fetchq_cnt)
+        std::int64_t fetch_queue_messages = 0;
+        std::int64_t committed_offset     = -1;
+        std::int64_t high_watermark       = -1;
+        std::int64_t consumer_lag         = -1;
+    };
+
+    struct KafkaMetrics {
+        std::string client_name;
+        std::chrono::system_clock::time_point collected_at;
+        // Messages and bytes in producer queues (msg_cnt, msg_size)
+        std::int64_t queued_messages   = 0;
+        std::int64_t queued_bytes      = 0;
+        std::int64_t sent_messages     = 0;
+        std::int64_t sent_bytes        = 0;
+        std::int64_t received_messages = 0;
+        std::int64_t received_bytes    = 0;
+        std::vector<KafkaBrokerMetrics> brokers;
+        std::vector<KafkaTopicMetrics> topics;
+        std::vector<KafkaPartitionMetrics> partitions;
+
+        // Sum of lags of partitions for which lag is known
+        std::int64_t total_consumer_lag() const;
+    };
+
+    // Latest snapshots of all channels of a messenger, keyed by channel name
+    struct KafkaMessengerMetrics {
+        std::map<std::string, KafkaMetrics> consumers;
+        std::map<std::string, KafkaMetrics> publishers;
+
+        std::int64_t total_consumer_lag() const;
+        std::int64_t total_queued_messages() const;
+    };
+
+    // Throws std::invalid_argument if statistics can't be parsed
+    KafkaMetrics parse_kafka_statistics(std::string_view json);
+
+    // Keeps the latest statistics emitted by librdkafka. Statistics callback only swaps raw JSON, so polling thread isn't
+    // slowed down by parsing - it's parsed on first metrics() call after each emission
+    class KafkaStatisticsCollector {
+      public:
+        KafkaStatisticsCollector();
+
+        void on_statistics(const std::string& json);
+        std::optional<KafkaMetrics> metrics() const;
+
+      private:
+        mutable std::mutex _mtx;
+        mutable std::string _raw_statistics;
+        mutable std::optional<KafkaMetrics> _metrics;
+        std::shared_ptr<logger::Logger> _logger;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
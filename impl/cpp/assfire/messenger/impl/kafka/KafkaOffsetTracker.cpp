@@ -0,0 +1,94 @@
+#include "KafkaOffsetTracker.hpp"
+
+#include <algorithm>
+
+namespace assfire::messenger {
+
+    namespace {
+        constexpr std::size_t INITIAL_SLOTS = 64;
+    }
+
+    void KafkaOffsetTracker::on_delivered(std::int32_t partition, std::int64_t offset) {
+        tbb::concurrent_hash_map<std::int32_t, PartitionOffsets>::accessor accessor;
+        _partitions.insert(accessor, partition);
+        accessor->second.on_delivered(offset);
+    }
+
+    std::optional<std::int64_t> KafkaOffsetTracker::ack(std::int32_t partition, std::int64_t offset) {
+        tbb::concurrent_hash_map<std::int32_t, PartitionOffsets>::accessor accessor;
+        if (!_partitions.find(accessor, partition)) { return std::nullopt; }
+        return accessor->second.ack(offset);
+    }
+
+    void KafkaOffsetTracker::reset(std::int32_t partition) {
+        _partitions.erase(partition);
+    }
+
+    void KafkaOffsetTracker::reset() {
+        _partitions.clear();
+    }
+
+    std::size_t KafkaOffsetTracker::in_flight(std::int32_t partition) const {
+        tbb::concurrent_hash_map<std::int32_t, PartitionOffsets>::const_accessor accessor;
+        if (!_partitions.find(accessor, partition)) { return 0; }
+        return accessor->second.in_flight();
+    }
+
+    // Offsets skipped between deliveries get skipped slots, so acks keep indexing slots directly by offset
+    void KafkaOffsetTracker::PartitionOffsets::on_delivered(std::int64_t offset) {
+        // Redelivered offsets are already tracked
+        if (offset < _end) { return; }
+
+        // Nothing is in flight, so gap before offset needs no slots
+        if (_begin == _end) {
+            _begin = offset;
+            _end   = offset;
+        }
+        reserve(static_cast<std::size_t>(offset - _begin + 1));
+        for (; _end < offset; ++_end) {
+            slot(static_cast<std::size_t>(_end - _begin)) = Slot::SKIPPED;
+        }
+        slot(static_cast<std::size_t>(offset - _begin)) = Slot::DELIVERED;
+        _end = offset + 1;
+        ++_in_flight;
+    }
+
+    std::optional<std::int64_t> KafkaOffsetTracker::PartitionOffsets::ack(std::int64_t offset) {
+        if (offset < _begin || offset >= _end) { return std::nullopt; }
+        Slot& acked = slot(static_cast<std::size_t>(offset - _begin));
+        if (acked != Slot::DELIVERED) { return std::nullopt; }
+        acked = Slot::ACKED;
+        if (offset != _begin) { return std::nullopt; }
+
+        while (_begin < _end && slot(0) != Slot::DELIVERED) {
+            if (slot(0) == Slot::ACKED) { --_in_flight; }
+            _head = (_head + 1) & (_slots.size() - 1);
+            ++_begin;
+        }
+        return _begin;
+    }
+
+    std::size_t KafkaOffsetTracker::PartitionOffsets::in_flight() const {
+        return _in_flight;
+    }
+
+    KafkaOffsetTracker::PartitionOffsets::Slot& KafkaOffsetTracker::PartitionOffsets::slot(std::size_t index) {
+        return _slots[(_head + index) & (_slots.size() - 1)];
+    }
+
+    void KafkaOffsetTracker::PartitionOffsets::reserve(std::size_t count) {
+        if (count <= _slots.size()) { return; }
+        std::size_t size = std::max(_slots.size(), INITIAL_SLOTS);
+        while (size < count) {
+            size *= 2;
+        }
+        std::vector<Slot> slots(size);
+        std::size_t used = static_cast<std::size_t>(_end - _begin);
+        for (std::size_t i = 0; i < used; ++i) {
+            slots[i] = slot(i);
+        }
+        _slots = std::move(slots);
+        _head  = 0;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
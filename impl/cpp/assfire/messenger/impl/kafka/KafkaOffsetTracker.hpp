@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <oneapi/tbb/concurrent_hash_map.h>
+#include <optional>
+#include <vector>
+
+namespace assfire::messenger {
+    // Tracks acks of delivered offsets per partition and reports commit watermark which is the offset
+    // following the longest contiguous prefix of acked offsets. Every offset from the first in-flight one to the last delivered one
+    // has a slot in a ring indexed by offset, so ack is O(1) and memory is proportional to the in-flight offset range
+    class KafkaOffsetTracker {
+      public:
+        // Must be called in offset order for each partition. Offsets skipped between deliveries (compacted records,
+        // transaction markers) are never delivered, so they are treated as acked
+        void on_delivered(std::int32_t partition, std::int64_t offset);
+
+        // Returns new commit watermark when this ack extends contiguous acked prefix, otherwise nothing.
+        // Watermark moves past acked and skipped offsets, each of them is released once
+        std::optional<std::int64_t> ack(std::int32_t partition, std::int64_t offset);
+
+        // Forgets partition state, i.e. when partition is revoked
+        void reset(std::int32_t partition);
+        void reset();
+
+        // Delivered offsets which are either unacked or wait for earlier ones to be acked
+        std::size_t in_flight(std::int32_t partition) const;
+
+      private:
+        class PartitionOffsets {
+          public:
+            void on_delivered(std::int64_t offset);
+            std::optional<std::int64_t> ack(std::int64_t offset);
+            std::size_t in_flight() const;
+
+          private:
+            enum class Slot : std::uint8_t { DELIVERED, ACKED, SKIPPED };
+
+            Slot& slot(std::size_t index);
+            void reserve(std::size_t count);
+
+            // Slots of offsets from _begin to _end are stored from _head, wrapping around _slots.size(), which is a power of two.
+            // _end follows the last delivered offset
+            std::vector<Slot> _slots;
+            std::size_t _head      = 0;
+            std::int64_t _begin    = 0;
+            std::int64_t _end      = 0;
+            std::size_t _in_flight = 0;
+        };
+
+        tbb::concurrent_hash_map<std::int32_t, PartitionOffsets> _partitions;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -285,6 +285,14 @@ namespace assfire::messenger {
                 : Property(kafka::clients::consumer::Config::SECURITY_PROTOCOL, value, security_protocol_formatter()) {};
         };
 
+        // Interval of librdkafka statistics emission, 0 disables statistics
+        class StatisticsIntervalMs : public ConstrainedIntProperty<int32_t, 0, 86400000> {
+          public:
+            StatisticsIntervalMs(std::optional<int32_t> value = std::nullopt)
+                : ConstrainedIntProperty<int32_t, 0, 86400000>("statistics.interval.ms", value) {};
+            StatisticsIntervalMs(int32_t value) : ConstrainedIntProperty<int32_t, 0, 86400000>("statistics.interval.ms", value) {};
+        };
+
         enum class PartitionAssignmentStrategyEnum { RANGE, ROUND_ROBIN };
 
         class PartitionAssignmentStrategy : public Property<PartitionAssignmentStrategyEnum> {
@@ -430,5 +438,40 @@ namespace assfire::messenger {
                 : ConstrainedIntProperty<int32_t, 1000, 2147483647>(kafka::clients::producer::Config::TRANSACTION_TIMEOUT_MS, value) {};
         };
 
+        enum class CompressionTypeEnum { NONE, GZIP, SNAPPY, LZ4, ZSTD };
+
+        class CompressionType : public Property<CompressionTypeEnum> {
+          private:
+            static Property<CompressionTypeEnum>::Formatter compression_type_formatter() {
+                return [](const auto& v) {
+                    switch (v) {
+                    case CompressionTypeEnum::NONE: return "none";
+                    case CompressionTypeEnum::GZIP: return "gzip";
+                    case CompressionTypeEnum::SNAPPY: return "snappy";
+                    case CompressionTypeEnum::LZ4: return "lz4";
+                    case CompressionTypeEnum::ZSTD: return "zstd";
+                    default: throw std::invalid_argument("Unexpected compression type enum value");
+                    }
+                };
+            }
+
+          public:
+            CompressionType(std::optional<CompressionTypeEnum> value = std::nullopt)
+                : Property("compression.type", value, compression_type_formatter()) {};
+            CompressionType(CompressionTypeEnum value) : Property("compression.type", value, compression_type_formatter()) {};
+
+            static std::string name_of(CompressionTypeEnum value) {
+                return compression_type_formatter()(value);
+            }
+        };
+
+        // Level of chosen compression codec: 0-9 for gzip, 0-12 for lz4, 1-12 for zstd (higher values are clamped by librdkafka),
+        // -1 for codec's default level. Snappy has no levels
+        class CompressionLevel : public ConstrainedIntProperty<int32_t, -1, 12> {
+          public:
+            CompressionLevel(std::optional<int32_t> value = std::nullopt) : ConstrainedIntProperty<int32_t, -1, 12>("compression.level", value) {};
+            CompressionLevel(int32_t value) : ConstrainedIntProperty<int32_t, -1, 12>("compression.level", value) {};
+        };
+
     }; // namespace KafkaOptions
 } // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "KafkaPartitioner.hpp"
+
+namespace assfire::messenger {
+
+    std::optional<std::int32_t> HeaderHashPartitioner::partition(const Message& msg, std::int32_t partitions_count) const {
+        if (partitions_count <= 0) { return std::nullopt; }
+        auto value = msg.header_view(_header.name());
+        if (!value) { return std::nullopt; }
+        return jump_consistent_hash(fnv1a_hash(*value), partitions_count);
+    }
+
+    std::uint64_t fnv1a_hash(std::string_view value) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : value) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Lamping & Veach, "A Fast, Minimal Memory, Consistent Hash Algorithm"
+    std::int32_t jump_consistent_hash(std::uint64_t key, std::int32_t buckets_count) {
+        std::int64_t bucket = -1;
+        std::int64_t next   = 0;
+        while (next < buckets_count) {
+            bucket = next;
+            key    = key * 2862933555777941757ull + 1;
+            next   = static_cast<std::int64_t>(static_cast<double>(bucket + 1) *
+                                             (static_cast<double>(1ll << 31) / static_cast<double>((key >> 33) + 1)));
+        }
+        return static_cast<std::int32_t>(bucket);
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "assfire/messenger/api/HeaderId.hpp"
+#include "assfire/messenger/api/Message.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace assfire::messenger {
+    // In-process partitioner which picks target partition before message is handed to librdkafka
+    class KafkaPartitioner {
+      public:
+        virtual ~KafkaPartitioner() = default;
+
+        // Returns nothing to leave partition choice to librdkafka, which partitions by message key if it is set
+        virtual std::optional<std::int32_t> partition(const Message& msg, std::int32_t partitions_count) const = 0;
+    };
+
+    // Maps messages with equal value of given header to the same partition. Jump consistent hash is used,
+    // so adding partitions to topic moves only a minimal share of header values to other partitions
+    class HeaderHashPartitioner : public KafkaPartitioner {
+      public:
+        explicit HeaderHashPartitioner(HeaderId header) : _header(header) {}
+
+        virtual std::optional<std::int32_t> partition(const Message& msg, std::int32_t partitions_count) const override;
+
+      private:
+        HeaderId _header;
+    };
+
+    std::uint64_t fnv1a_hash(std::string_view value);
+    std::int32_t jump_consistent_hash(std::uint64_t key, std::int32_t buckets_count);
+} // namespace assfire::messenger
\ No newline at end of file
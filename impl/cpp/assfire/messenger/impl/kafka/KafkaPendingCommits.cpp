@@ -0,0 +1,54 @@
+#include "KafkaPendingCommits.hpp"
+
+#include <algorithm>
+
+namespace assfire::messenger {
+
+    namespace {
+        bool exceeds(const std::map<std::int32_t, std::int64_t>& offsets, std::int32_t partition, std::int64_t offset) {
+            auto iter = offsets.find(partition);
+            return iter == offsets.end() || offset > iter->second;
+        }
+    } // namespace
+
+    void KafkaPendingCommits::add(std::int32_t partition, std::int64_t offset) {
+        auto [iter, inserted] = _pending.emplace(partition, offset);
+        if (!inserted) { iter->second = std::max(iter->second, offset); }
+    }
+
+    std::map<std::int32_t, std::int64_t> KafkaPendingCommits::take() {
+        std::map<std::int32_t, std::int64_t> result;
+        for (const auto& [partition, offset] : _pending) {
+            if (!exceeds(_committed, partition, offset)) { continue; }
+            result.emplace(partition, offset);
+            std::int64_t& sent = _sent[partition];
+            sent               = std::max(sent, offset);
+        }
+        _pending.clear();
+        return result;
+    }
+
+    void KafkaPendingCommits::on_committed(std::int32_t partition, std::int64_t offset) {
+        auto [iter, inserted] = _committed.emplace(partition, offset);
+        if (!inserted) { iter->second = std::max(iter->second, offset); }
+    }
+
+    // Newer sent offset either gets committed or is retried by its own failure, so retrying older one could only move group back
+    void KafkaPendingCommits::on_failed(std::int32_t partition, std::int64_t offset) {
+        auto sent = _sent.find(partition);
+        if (sent == _sent.end() || offset < sent->second) { return; }
+        if (!exceeds(_committed, partition, offset)) { return; }
+        add(partition, offset);
+    }
+
+    void KafkaPendingCommits::reset(std::int32_t partition) {
+        _pending.erase(partition);
+        _sent.erase(partition);
+        _committed.erase(partition);
+    }
+
+    bool KafkaPendingCommits::empty() const {
+        return _pending.empty();
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
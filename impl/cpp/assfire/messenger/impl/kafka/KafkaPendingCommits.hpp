@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace assfire::messenger {
+    // Offsets waiting to be committed asynchronously, per partition. Commits may complete out of order, so failed commit is only
+    // retried if no newer offset of its partition was sent for commit since, and offsets never go below the last committed one.
+    // Not thread-safe, callers serialize access
+    class KafkaPendingCommits {
+      public:
+        // Keeps the highest offset added for partition since it was last taken
+        void add(std::int32_t partition, std::int64_t offset);
+
+        // Returns pending offsets which are above the last committed ones and marks them as sent
+        std::map<std::int32_t, std::int64_t> take();
+
+        void on_committed(std::int32_t partition, std::int64_t offset);
+        // Offset is pending again unless it is superseded by a newer sent or committed offset
+        void on_failed(std::int32_t partition, std::int64_t offset);
+
+        // Forgets partition state, i.e. when partition is revoked
+        void reset(std::int32_t partition);
+
+        bool empty() const;
+
+      private:
+        std::map<std::int32_t, std::int64_t> _pending;
+        std::map<std::int32_t, std::int64_t> _sent;
+        std::map<std::int32_t, std::int64_t> _committed;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -1,21 +1,394 @@
 #include "KafkaPublisher.hpp"
 
 #include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <librdkafka/rdkafka.h>
+#include <mutex>
+#include <shared_mutex>
 
 namespace assfire::messenger {
 
-    KafkaPublisher::KafkaPublisher(std::shared_ptr<kafka::clients::KafkaProducer> producer, KafkaPublisherOptions options)
-        : _producer(std::move(producer)),
+    namespace {
+        // Errors after which the same message may be delivered later, i.e. when brokers are unreachable or partition leader is moving
+        bool is_retriable(const kafka::Error& error) {
+            switch (error.value()) {
+                case RD_KAFKA_RESP_ERR__MSG_TIMED_OUT:
+                case RD_KAFKA_RESP_ERR__TIMED_OUT:
+                case RD_KAFKA_RESP_ERR__TRANSPORT:
+                case RD_KAFKA_RESP_ERR__ALL_BROKERS_DOWN:
+                case RD_KAFKA_RESP_ERR__QUEUE_FULL:
+                case RD_KAFKA_RESP_ERR_REQUEST_TIMED_OUT:
+                case RD_KAFKA_RESP_ERR_LEADER_NOT_AVAILABLE:
+                case RD_KAFKA_RESP_ERR_NOT_LEADER_FOR_PARTITION:
+                case RD_KAFKA_RESP_ERR_NOT_ENOUGH_REPLICAS:
+                case RD_KAFKA_RESP_ERR_NOT_ENOUGH_REPLICAS_AFTER_APPEND:
+                case RD_KAFKA_RESP_ERR_NETWORK_EXCEPTION:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // Single delivery tracker shared by all messages of a batch. Delivery callbacks capture only a reference to it and the message index,
+        // so they fit into std::function's inline storage. Kafka producer still allocates its own delivery opaque for every record
+        class BatchDelivery {
+          public:
+            explicit BatchDelivery(std::size_t size) : _pending(size) {}
+
+            void on_delivered(std::size_t index, const kafka::Error& error) {
+                std::lock_guard<std::mutex> lck(_mtx);
+                if (error) {
+                    _failures.emplace_back(index, error.message());
+                    _retriable_failures |= is_retriable(error);
+                }
+                complete_one();
+            }
+
+            void on_send_failed(std::size_t index, std::string error, bool retriable = false) {
+                std::lock_guard<std::mutex> lck(_mtx);
+                _failures.emplace_back(index, std::move(error));
+                _retriable_failures |= retriable;
+                complete_one();
+            }
+
+            // Valid after wait
+            bool has_retriable_failures() const {
+                return _retriable_failures;
+            }
+
+            std::vector<PublishFailure> wait() {
+                std::unique_lock<std::mutex> lck(_mtx);
+                _done_cv.wait(lck, [&] { return _pending == 0; });
+                std::sort(_failures.begin(), _failures.end(), [](const auto& lhs, const auto& rhs) { return lhs.index() < rhs.index(); });
+                return std::move(_failures);
+            }
+
+          private:
+            // Called with _mtx held: tracker lives on waiter's stack, so it must not be touched after waiter can see the last completion
+            void complete_one() {
+                if (--_pending == 0) { _done_cv.notify_all(); }
+            }
+
+            std::size_t _pending;
+            std::mutex _mtx;
+            std::condition_variable _done_cv;
+            std::vector<PublishFailure> _failures;
+            bool _retriable_failures = false;
+        };
+
+        // Publishers are blocked while replaced producer is flushed, so codec isn't switched if it takes longer
+        constexpr std::chrono::milliseconds SWITCH_FLUSH_TIMEOUT = std::chrono::seconds(10);
+        // Partitions may be added to topic at any time, so their count is refetched as often as librdkafka refreshes its metadata by default
+        constexpr std::chrono::milliseconds PARTITIONS_REFRESH_INTERVAL = std::chrono::minutes(5);
+        constexpr std::chrono::milliseconds PARTITIONS_RETRY_BACKOFF    = std::chrono::seconds(1);
+
+        KafkaOptions::CompressionTypeEnum compression_of(const KafkaPublisherOptions& options) {
+            return options.compression_type().value().value_or(KafkaOptions::CompressionTypeEnum::NONE);
+        }
+    } // namespace
+
+    KafkaPublisher::KafkaPublisher(KafkaPublisherOptions options)
+        : _producers({{compression_of(options), create_producer(options)}}),
+          _producer(_producers.begin()->second.get()),
+          _partitions_count(0),
           _options(std::move(options)),
-          _logger(logger::LoggerProvider::get("assfire.messenger.KafkaPublisher")) {}
+          _logger(logger::LoggerProvider::get("assfire.messenger.KafkaPublisher")) {
+        if (const auto& adaptive_compression = _options.adaptive_compression()) {
+            if (_options.transactional_id().value()) {
+                throw std::invalid_argument("Adaptive compression can't replace transactional producer of topic " + _options.topic_name());
+            }
+            _compression = std::make_unique<KafkaCompressionSelector>(
+                *adaptive_compression, _options.compression_type().value().value_or(KafkaOptions::CompressionTypeEnum::NONE),
+                _options.compression_level().value());
+        }
+        if (const auto& spool = _options.spool()) {
+            _spool = std::make_shared<KafkaSpool>(*spool, [this](std::span<const Message> messages) { return replay(messages); });
+        }
+        // Metadata fetch may take seconds, so the first one is done by refresher rather than by publisher's creator
+        if (_options.custom_partitioner()) { _partitions_refresher = std::thread([this] { refresh_partitions_count(); }); }
+    }
+
+    // Replay uses producer, so drainer is stopped before producer is closed. Delivery callbacks refer to this publisher,
+    // so producers are closed here, while members are alive, rather than by whoever releases them last
+    KafkaPublisher::~KafkaPublisher() {
+        {
+            std::lock_guard<std::mutex> lck(_refresh_mtx);
+            _closing = true;
+            _refresh_cv.notify_all();
+        }
+        if (_partitions_refresher.joinable()) { _partitions_refresher.join(); }
+        if (_switch_ftr.valid()) { _switch_ftr.wait(); }
+        if (_spool) { _spool->stop(); }
+        for (const auto& [codec, producer] : _producers) {
+            producer->close();
+        }
+    }
 
     void KafkaPublisher::publish(const Message& msg) {
-        auto record =
-            kafka::clients::producer::ProducerRecord(_options.topic_name(), kafka::NullKey, kafka::Value(msg.payload().data(), msg.payload().size()));
+        sample_compression(msg);
+        if (_spool) {
+            publish_or_spool(msg);
+            return;
+        }
+
+        auto record = make_record(msg);
+
+        // Caller's message may be gone before delivery, so librdkafka keeps its own copy of the value.
+        // Callback captures nothing but this and is stored inline by std::function
+        auto lck = send_lock();
+        producer().send(
+            record,
+            [this](const kafka::clients::producer::RecordMetadata& metadata, const kafka::Error& error) {
+                if (error) { _logger->error("Message wasn't delivered to kafka: {}", metadata.toString()); }
+            },
+            kafka::clients::KafkaProducer::SendOption::ToCopyRecordValue);
+    }
+
+    void KafkaPublisher::publish(const Message& msg, DeliveryCallback callback) {
+        sample_compression(msg);
+
+        // Captured payload buffer keeps record value alive until delivery, so it is passed to librdkafka without copying.
+        // Callback is copied rather than moved, so it can still report the failure if message is never handed over to librdkafka
+        try {
+            auto record = make_record(msg);
+            auto lck    = send_lock();
+            producer().send(record, [this, payload = msg.payload(), callback](const kafka::clients::producer::RecordMetadata& metadata,
+                                                                              const kafka::Error& error) {
+                if (error) {
+                    _logger->error("Message wasn't delivered to kafka: {}", metadata.toString());
+                    callback(DeliveryReport(error.message()));
+                } else {
+                    callback(DeliveryReport(metadata.partition(), metadata.offset()));
+                }
+            });
+        } catch (const std::exception& e) {
+            _logger->error("Failed to send message to kafka: {}", e.what());
+            callback(DeliveryReport(e.what()));
+        }
+    }
+
+    // Payload is serialized into a buffer owned by the delivery callback, so librdkafka sends it without copying and it is freed on delivery
+    void KafkaPublisher::publish_serialized(std::size_t size, absl::FunctionRef<void(std::uint8_t*, std::size_t)> serialize) {
+        std::shared_ptr<std::uint8_t[]> buffer = std::make_shared_for_overwrite<std::uint8_t[]>(size);
+        serialize(buffer.get(), size);
+        Message msg(PayloadBuffer(buffer, buffer.get(), size));
+
+        sample_compression(msg);
+        if (_spool) {
+            publish_or_spool(msg);
+            return;
+        }
+
+        auto record = make_record(msg);
+        auto lck    = send_lock();
+        producer().send(
+            record,
+            [this, buffer = std::move(buffer)](const kafka::clients::producer::RecordMetadata& metadata, const kafka::Error& error) {
+                if (error) { _logger->error("Message wasn't delivered to kafka: {}", metadata.toString()); }
+            },
+            kafka::clients::KafkaProducer::SendOption::NoCopyRecordValue);
+    }
+
+    // Records are still produced one by one: rd_kafka_produce_batch doesn't support headers, and kafka producer's delivery report
+    // callback expects its own opaque on every message. Batch is sampled for compression once and sent under a single send lock
+    PublishBatchResult KafkaPublisher::publish_batch(std::span<const Message> messages) {
+        BatchDelivery delivery(messages.size());
+        if (!messages.empty()) { sample_compression(messages.front()); }
+
+        {
+            auto lck = send_lock();
+            kafka::clients::KafkaProducer& batch_producer = producer();
+            for (std::size_t i = 0; i < messages.size(); ++i) {
+                try {
+                    auto record = make_record(messages[i]);
+                    batch_producer.send(record, [&delivery, i](const kafka::clients::producer::RecordMetadata& metadata, const kafka::Error& error) {
+                        delivery.on_delivered(i, error);
+                    });
+                } catch (const std::exception& e) {
+                    _logger->error("Failed to send message #{} of batch to kafka: {}", i, e.what());
+                    delivery.on_send_failed(i, e.what());
+                }
+            }
+        }
+
+        std::vector<PublishFailure> failures = delivery.wait();
+        if (!failures.empty()) { _logger->error("{} of {} messages of batch weren't delivered to kafka", failures.size(), messages.size()); }
+        return PublishBatchResult(messages.size(), std::move(failures));
+    }
+
+    // While spool holds messages, new ones are appended behind them rather than sent, so they are delivered in publishing order.
+    // Messages already handed to librdkafka and spooled on failed delivery later may still be overtaken
+    void KafkaPublisher::publish_or_spool(const Message& msg) {
+        if (!_spool->empty()) {
+            _spool->append(msg);
+            return;
+        }
+
+        auto record = make_record(msg);
+
+        // Captured message keeps record value alive until delivery and is spooled if delivery fails with retriable error
+        try {
+            auto lck = send_lock();
+            producer().send(
+                record,
+                [this, spool = _spool, msg](const kafka::clients::producer::RecordMetadata& metadata, const kafka::Error& error) {
+                    if (!error) { return; }
+                    if (!is_retriable(error)) {
+                        _logger->error("Message wasn't delivered to kafka: {}", metadata.toString());
+                        return;
+                    }
+                    // Callbacks are run by producer's single polling thread, so waiting for disk here would flush messages one by one
+                    spool->append_async(msg);
+                },
+                kafka::clients::KafkaProducer::SendOption::NoCopyRecordValue, kafka::clients::KafkaProducer::ActionWhileQueueIsFull::NoBlock);
+        } catch (const kafka::KafkaException& e) {
+            if (e.error().value() != RD_KAFKA_RESP_ERR__QUEUE_FULL) { throw; }
+            _spool->append(msg);
+        }
+    }
+
+    bool KafkaPublisher::replay(std::span<const Message> messages) {
+        BatchDelivery delivery(messages.size());
+
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            try {
+                auto record = make_record(messages[i]);
+                auto lck    = send_lock();
+                producer().send(
+                    record,
+                    [&delivery, i](const kafka::clients::producer::RecordMetadata& metadata, const kafka::Error& error) {
+                        delivery.on_delivered(i, error);
+                    },
+                    kafka::clients::KafkaProducer::SendOption::NoCopyRecordValue, kafka::clients::KafkaProducer::ActionWhileQueueIsFull::NoBlock);
+            } catch (const kafka::KafkaException& e) {
+                delivery.on_send_failed(i, e.what(), is_retriable(e.error()));
+            } catch (const std::exception& e) { delivery.on_send_failed(i, e.what()); }
+        }
+
+        std::vector<PublishFailure> failures = delivery.wait();
+        if (failures.empty()) { return true; }
+        if (delivery.has_retriable_failures()) {
+            _logger->error("{} of {} replayed messages weren't delivered to kafka. They will be replayed again", failures.size(), messages.size());
+            return false;
+        }
+        _logger->error("{} of {} replayed messages weren't delivered to kafka and were dropped", failures.size(), messages.size());
+        return true;
+    }
+
+    std::optional<KafkaMetrics> KafkaPublisher::metrics() const {
+        return _statistics.metrics();
+    }
+
+    KafkaCompressionStats KafkaPublisher::compression_stats() const {
+        if (_compression) { return _compression->stats(); }
+        return KafkaCompressionStats(_options.compression_type().value().value_or(KafkaOptions::CompressionTypeEnum::NONE), std::nullopt, 0, false);
+    }
+
+    // Statistics callback is set once, right after construction and before producer is shared: its polling thread reads the callback
+    // without synchronization, and this kafka client version can't take it with config. The first statistics are only emitted after
+    // statistics interval. Only statistics of current producer are collected, as replaced producer doesn't send new messages
+    std::shared_ptr<kafka::clients::KafkaProducer> KafkaPublisher::create_producer(const KafkaPublisherOptions& options) {
+        auto producer = std::make_shared<kafka::clients::KafkaProducer>(options.to_kafka_config());
+        if (options.statistics_interval_ms().value().value_or(0) > 0) {
+            producer->setStatsCallback([this, raw_producer = producer.get()](const std::string& json) {
+                if (_producer.load(std::memory_order_acquire) == raw_producer) { _statistics.on_statistics(json); }
+            });
+        }
+        return producer;
+    }
+
+    // Codec is chosen again only after a whole reselection interval, so waiting for the previous switch virtually never blocks
+    void KafkaPublisher::sample_compression(const Message& msg) {
+        if (!_compression) { return; }
+        std::optional<KafkaOptions::CompressionTypeEnum> codec;
+        try {
+            codec = _compression->sample(msg.payload().span());
+        } catch (const std::exception& e) { _logger->error("Failed to sample compression of message to {}: {}", _options.topic_name(), e.what()); }
+        if (!codec) { return; }
+
+        std::lock_guard<std::mutex> lck(_switch_start_mtx);
+        if (_switch_ftr.valid()) { _switch_ftr.wait(); }
+        _switch_ftr = std::async(std::launch::async, [this, codec = *codec] { switch_codec(codec); });
+    }
+
+    // Runs in background, publishers keep sending through current producer until its replacement is ready
+    void KafkaPublisher::switch_codec(KafkaOptions::CompressionTypeEnum codec) {
+        try {
+            std::shared_ptr<kafka::clients::KafkaProducer> producer;
+            if (auto it = _producers.find(codec); it != _producers.end()) {
+                producer = it->second;
+            } else {
+                KafkaPublisherOptions options = _options;
+                options.set_compression_type(codec);
+                producer = create_producer(options);
+            }
+
+            // Messages queued by replaced producer are delivered before replacement sends anything, so they aren't overtaken
+            std::unique_lock<std::shared_mutex> lck(_switch_mtx);
+            if (kafka::Error error = this->producer().flush(SWITCH_FLUSH_TIMEOUT)) {
+                _logger->error("Publisher of {} keeps its compression: failed to flush messages queued before switching to {} compression: {}",
+                               _options.topic_name(), KafkaOptions::CompressionType::name_of(codec), error.message());
+                return;
+            }
+            _producers.emplace(codec, producer);
+            _producer.store(producer.get(), std::memory_order_release);
+        } catch (const std::exception& e) {
+            _logger->error("Failed to switch publisher of {} to {} compression: {}", _options.topic_name(),
+                           KafkaOptions::CompressionType::name_of(codec), e.what());
+            return;
+        }
+        _logger->info("Publisher of {} switched to {} compression", _options.topic_name(), KafkaOptions::CompressionType::name_of(codec));
+    }
+
+    // Key and headers are referenced by the record and copied by librdkafka while producing
+    kafka::clients::producer::ProducerRecord KafkaPublisher::make_record(const Message& msg) {
+        kafka::Key key   = msg.key() ? kafka::Key(msg.key()->data(), msg.key()->size()) : kafka::NullKey;
+        kafka::Value value(msg.payload().data(), msg.payload().size());
+
+        // Librdkafka partitions messages published before partitions count is known
+        std::optional<std::int32_t> partition;
+        std::int32_t partitions_count = _partitions_count.load(std::memory_order_relaxed);
+        if (const auto& partitioner = _options.custom_partitioner(); partitioner && partitions_count > 0) {
+            partition = partitioner->partition(msg, partitions_count);
+        }
+        auto record = partition ? kafka::clients::producer::ProducerRecord(_options.topic_name(), *partition, key, value)
+                                : kafka::clients::producer::ProducerRecord(_options.topic_name(), key, value);
+
+        if (!msg.headers().empty()) {
+            kafka::Headers headers;
+            headers.reserve(msg.headers().size());
+            for (const Header& h : msg.headers()) {
+                headers.emplace_back(h.id().name(), kafka::Header::Value(h.value().data(), h.value().size()));
+            }
+            record.setHeaders(headers);
+        }
+        return record;
+    }
+
+    // Until partitions count is known, custom partitioner gets 0 and messages are partitioned by librdkafka
+    bool KafkaPublisher::fetch_partitions_count() {
+        try {
+            auto metadata = producer().fetchBrokerMetadata(_options.topic_name());
+            if (metadata && !metadata->partitions().empty()) {
+                _partitions_count.store(static_cast<std::int32_t>(metadata->partitions().size()), std::memory_order_relaxed);
+                return true;
+            }
+            _logger->error("Failed to fetch partitions of topic {}: no metadata was returned", _options.topic_name());
+        } catch (const std::exception& e) { _logger->error("Failed to fetch partitions of topic {}: {}", _options.topic_name(), e.what()); }
+        return false;
+    }
 
-        _producer->send(record, [this](const kafka::clients::producer::RecordMetadata& metadata, const kafka::Error& error) {
-            if (error) { _logger->error("Message wasn't delivered to kafka: {}", metadata.toString()); }
-        });
+    void KafkaPublisher::refresh_partitions_count() {
+        bool fetched = fetch_partitions_count();
+        std::unique_lock<std::mutex> lck(_refresh_mtx);
+        while (!_refresh_cv.wait_for(lck, fetched ? PARTITIONS_REFRESH_INTERVAL : PARTITIONS_RETRY_BACKOFF, [&] { return _closing; })) {
+            lck.unlock();
+            fetched = fetch_partitions_count();
+            lck.lock();
+        }
     }
 
 } // namespace assfire::messenger
\ No newline at end of file
@@ -1,26 +1,103 @@
 #pragma once
 
+#include "KafkaCompressionSelector.hpp"
+#include "KafkaCompressionStats.hpp"
+#include "KafkaMetrics.hpp"
 #include "KafkaPublisherOptions.hpp"
+#include "KafkaSpool.hpp"
 #include "assfire/logger/api/Logger.hpp"
 #include "assfire/messenger/api/Publisher.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <future>
 #include <kafka/KafkaProducer.h>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
 
 namespace assfire::messenger {
     class KafkaPublisher : public Publisher {
       public:
-        KafkaPublisher(std::shared_ptr<kafka::clients::KafkaProducer> producer, KafkaPublisherOptions options);
+        // Throws std::runtime_error if spool is configured and can't be opened.
+        // Throws std::invalid_argument if adaptive compression is configured for transactional producer
+        // Kafka producer is created by publisher, so statistics callback is registered before anything else can use the producer
+        explicit KafkaPublisher(KafkaPublisherOptions options);
+        // Blocks until batch being replayed from spool is delivered or times out, up to message.timeout.ms,
+        // and until producers flush messages they still hold
+        ~KafkaPublisher();
 
+        using Publisher::publish;
         virtual void publish(const Message& msg) override;
+        virtual void publish(const Message& msg, DeliveryCallback callback) override;
+        virtual PublishBatchResult publish_batch(std::span<const Message> messages) override;
+        virtual void publish_serialized(std::size_t size, absl::FunctionRef<void(std::uint8_t*, std::size_t)> serialize) override;
 
         const KafkaPublisherOptions& options() const {
             return _options;
         }
 
+        // Latest librdkafka statistics, empty until statistics interval is configured and first statistics are emitted
+        std::optional<KafkaMetrics> metrics() const;
+
+        // Current codec and its ratio on sampled messages. Ratio is only measured with adaptive compression
+        KafkaCompressionStats compression_stats() const;
+
+        // Partitions of topic seen by custom partitioner. Zero until it is fetched, messages are partitioned by librdkafka meanwhile
+        std::int32_t partitions_count() const {
+            return _partitions_count.load(std::memory_order_relaxed);
+        }
+
+        // Empty unless spool is configured
+        const std::shared_ptr<KafkaSpool>& spool() const {
+            return _spool;
+        }
+
       private:
-        std::shared_ptr<kafka::clients::KafkaProducer> _producer;
+        kafka::clients::KafkaProducer& producer() const {
+            return *_producer.load(std::memory_order_acquire);
+        }
+
+        // Held while sending through current producer, so it isn't replaced in the middle of a send
+        std::shared_lock<std::shared_mutex> send_lock() {
+            return _compression ? std::shared_lock<std::shared_mutex>(_switch_mtx) : std::shared_lock<std::shared_mutex>();
+        }
+
+        kafka::clients::producer::ProducerRecord make_record(const Message& msg);
+        bool fetch_partitions_count();
+        void refresh_partitions_count();
+        void publish_or_spool(const Message& msg);
+        bool replay(std::span<const Message> messages);
+        std::shared_ptr<kafka::clients::KafkaProducer> create_producer(const KafkaPublisherOptions& options);
+        void sample_compression(const Message& msg);
+        void switch_codec(KafkaOptions::CompressionTypeEnum codec);
+
+        // Declared before producer, so it outlives producer's polling thread which emits statistics
+        KafkaStatisticsCollector _statistics;
+        // Producer is replaced in background whenever adaptive compression chooses another codec. Replaced producer is flushed before
+        // its replacement sends anything, so ordering within partitions is kept. Producers are kept per codec until publisher is destroyed,
+        // so switching back to a codec reuses its producer
+        std::map<KafkaOptions::CompressionTypeEnum, std::shared_ptr<kafka::clients::KafkaProducer>> _producers;
+        std::atomic<kafka::clients::KafkaProducer*> _producer;
+        std::shared_mutex _switch_mtx;
+        // Switches are started one at a time, the next one waits for the previous one to finish
+        std::mutex _switch_start_mtx;
+        std::future<void> _switch_ftr;
+        // Fetched and refreshed in background while custom partitioner is configured, zero until a fetch succeeds
+        std::atomic<std::int32_t> _partitions_count;
+        std::mutex _refresh_mtx;
+        std::condition_variable _refresh_cv;
+        bool _closing = false;
+        std::thread _partitions_refresher;
         KafkaPublisherOptions _options;
+        std::unique_ptr<KafkaCompressionSelector> _compression;
+        // Shared with delivery callbacks, which may spool undelivered messages while producer is being closed.
+        // Spool writer finishes messages queued by them once the last callback releases it
+        std::shared_ptr<KafkaSpool> _spool;
         std::shared_ptr<logger::Logger> _logger;
     };
 } // namespace assfire::messenger
\ No newline at end of file
@@ -1,11 +1,16 @@
 #pragma once
 
+#include "KafkaAdaptiveCompressionOptions.hpp"
 #include "KafkaOptions.hpp"
+#include "KafkaPartitioner.hpp"
+#include "KafkaSpoolOptions.hpp"
 #include "kafka/ConsumerConfig.h"
 
 #include <absl/strings/str_join.h>
 #include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_set>
 
@@ -40,6 +45,11 @@ namespace assfire::messenger {
             tokens.push_back(_transactional_id.to_string());
             tokens.push_back(_transaction_timeout_ms.to_string());
             tokens.push_back(_security_protocol.to_string());
+            tokens.push_back(_statistics_interval_ms.to_string());
+            tokens.push_back(_compression_type.to_string());
+            tokens.push_back(_compression_level.to_string());
+            if (_adaptive_compression) { tokens.push_back("adaptive_compression = " + _adaptive_compression->to_string()); }
+            if (_spool) { tokens.push_back("spool = " + _spool->to_string()); }
             std::erase_if(tokens, [](const auto &s) { return s.empty(); });
             return "{" + absl::StrJoin(tokens, ",") + "}";
         }
@@ -63,6 +73,9 @@ namespace assfire::messenger {
             _transactional_id.fill_config(result);
             _transaction_timeout_ms.fill_config(result);
             _security_protocol.fill_config(result);
+            _statistics_interval_ms.fill_config(result);
+            _compression_type.fill_config(result);
+            _compression_level.fill_config(result);
             return result;
         }
 
@@ -150,6 +163,14 @@ namespace assfire::messenger {
             _partitioner = partitioner;
         }
 
+        // Chooses partition in-process instead of librdkafka partitioner configured with set_partitioner
+        const std::shared_ptr<const KafkaPartitioner> &custom_partitioner() const {
+            return _custom_partitioner;
+        }
+        void set_custom_partitioner(std::shared_ptr<const KafkaPartitioner> custom_partitioner) {
+            _custom_partitioner = std::move(custom_partitioner);
+        }
+
         KafkaOptions::MaxInFlight max_in_flight() const {
             return _max_in_flight;
         }
@@ -185,6 +206,45 @@ namespace assfire::messenger {
             _security_protocol = security_protocol;
         }
 
+        KafkaOptions::StatisticsIntervalMs statistics_interval_ms() const {
+            return _statistics_interval_ms;
+        }
+        void set_statistics_interval_ms(const KafkaOptions::StatisticsIntervalMs &statistics_interval_ms) {
+            _statistics_interval_ms = statistics_interval_ms;
+        }
+
+        KafkaOptions::CompressionType compression_type() const {
+            return _compression_type;
+        }
+        void set_compression_type(const KafkaOptions::CompressionType &compression_type) {
+            _compression_type = compression_type;
+        }
+
+        KafkaOptions::CompressionLevel compression_level() const {
+            return _compression_level;
+        }
+        void set_compression_level(const KafkaOptions::CompressionLevel &compression_level) {
+            _compression_level = compression_level;
+        }
+
+        // When set, publisher samples published payloads and switches to the codec which pays off for them. With default probes
+        // the choice is between gzip and no compression. Compression type then only sets codec used until the choice is made
+        const std::optional<KafkaAdaptiveCompressionOptions> &adaptive_compression() const {
+            return _adaptive_compression;
+        }
+        void set_adaptive_compression(std::optional<KafkaAdaptiveCompressionOptions> adaptive_compression) {
+            _adaptive_compression = std::move(adaptive_compression);
+        }
+
+        // When set, messages published without delivery callback are spooled to disk instead of blocking publisher
+        // while librdkafka queue is full, or lost when their delivery fails with retriable error, and replayed later
+        const std::optional<KafkaSpoolOptions> &spool() const {
+            return _spool;
+        }
+        void set_spool(std::optional<KafkaSpoolOptions> spool) {
+            _spool = std::move(spool);
+        }
+
         const std::string &topic_name() const {
             return _topic_name;
         }
@@ -210,6 +270,13 @@ namespace assfire::messenger {
         KafkaOptions::TransactionalId _transactional_id;
         KafkaOptions::TransactionTimeoutMs _transaction_timeout_ms;
         KafkaOptions::SecurityProtocol _security_protocol;
+        KafkaOptions::StatisticsIntervalMs _statistics_interval_ms;
+        KafkaOptions::CompressionType _compression_type;
+        KafkaOptions::CompressionLevel _compression_level;
+
+        std::shared_ptr<const KafkaPartitioner> _custom_partitioner;
+        std::optional<KafkaAdaptiveCompressionOptions> _adaptive_compression;
+        std::optional<KafkaSpoolOptions> _spool;
 
         std::string _topic_name;
     };
@@ -0,0 +1,21 @@
+#include "KafkaRecord.hpp"
+
+namespace assfire::messenger {
+
+    std::optional<std::string_view> KafkaRecord::find(std::string_view id) const {
+        std::lock_guard<std::mutex> lck(_headers_mtx);
+        kafka::Header::Value value = _record.lastHeaderValue(kafka::Header::Key(id));
+        if (!value.data()) { return std::nullopt; }
+        return std::string_view(static_cast<const char*>(value.data()), value.size());
+    }
+
+    std::vector<Header> KafkaRecord::to_headers() const {
+        std::lock_guard<std::mutex> lck(_headers_mtx);
+        std::vector<Header> result;
+        for (const auto& h : _record.headers()) {
+            result.emplace_back(h.key, Header::Value(static_cast<const char*>(h.value.data()), h.value.size()));
+        }
+        return result;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
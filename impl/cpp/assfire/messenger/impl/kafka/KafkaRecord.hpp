@@ -0,0 +1,36 @@
+#pragma once
+
+#include "assfire/messenger/api/RecordHeaders.hpp"
+
+#include <cstdint>
+#include <kafka/KafkaConsumer.h>
+#include <mutex>
+
+namespace assfire::messenger {
+    // Owns consumed kafka record for as long as any message refers to its payload or headers.
+    // Header lookups go straight to librdkafka message, so received headers are never copied upfront
+    class KafkaRecord : public RecordHeaders {
+      public:
+        explicit KafkaRecord(kafka::clients::consumer::ConsumerRecord record) : _record(std::move(record)) {}
+
+        const kafka::clients::consumer::ConsumerRecord& record() const {
+            return _record;
+        }
+
+        const uint8_t* value_data() const {
+            return static_cast<const uint8_t*>(_record.value().data());
+        }
+
+        std::size_t value_size() const {
+            return _record.value().size();
+        }
+
+        virtual std::optional<std::string_view> find(std::string_view id) const override;
+        virtual std::vector<Header> to_headers() const override;
+
+      private:
+        // librdkafka parses message headers lazily on first access, so concurrent lookups are serialized
+        mutable std::mutex _headers_mtx;
+        mutable kafka::clients::consumer::ConsumerRecord _record;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
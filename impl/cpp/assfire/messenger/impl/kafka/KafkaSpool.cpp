@@ -0,0 +1,256 @@
+#include "KafkaSpool.hpp"
+
+#include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace assfire::messenger {
+
+    namespace {
+        constexpr std::uint32_t NO_KEY = UINT32_MAX;
+
+        void put_u32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            std::uint8_t bytes[sizeof(value)];
+            std::memcpy(bytes, &value, sizeof(value));
+            out.insert(out.end(), bytes, bytes + sizeof(value));
+        }
+
+        void put_bytes(std::vector<std::uint8_t>& out, std::string_view value) {
+            out.insert(out.end(), value.begin(), value.end());
+        }
+
+        class Reader {
+          public:
+            explicit Reader(std::span<const std::uint8_t> data) : _data(data) {}
+
+            std::uint32_t u32() {
+                std::uint32_t value;
+                std::memcpy(&value, take(sizeof(value)).data(), sizeof(value));
+                return value;
+            }
+
+            std::string_view bytes(std::size_t size) {
+                auto span = take(size);
+                return std::string_view(reinterpret_cast<const char*>(span.data()), span.size());
+            }
+
+            std::span<const std::uint8_t> rest() {
+                return take(_data.size());
+            }
+
+          private:
+            std::span<const std::uint8_t> take(std::size_t size) {
+                if (size > _data.size()) { throw std::invalid_argument("Spooled message is truncated"); }
+                auto result = _data.first(size);
+                _data       = _data.subspan(size);
+                return result;
+            }
+
+            std::span<const std::uint8_t> _data;
+        };
+    } // namespace
+
+    KafkaSpool::KafkaSpool(KafkaSpoolOptions options, ReplayFunction replay)
+        : _options(std::move(options)),
+          _replay(std::move(replay)),
+          _log(_options.directory(), _options.segment_size(), _options.max_segments()),
+          _spooled_messages(0),
+          _replayed_messages(0),
+          _spooling(false),
+          _queued_messages(0),
+          _logger(logger::LoggerProvider::get("assfire.messenger.KafkaSpool")) {
+        if (!_log.empty()) { _logger->info("Found messages left in spool {}. They will be replayed", _options.directory()); }
+        _drainer = std::thread([this] { drain_loop(); });
+        _writer  = std::thread([this] { write_loop(); });
+    }
+
+    KafkaSpool::~KafkaSpool() {
+        stop();
+        {
+            std::lock_guard<std::mutex> lck(_write_mtx);
+            _closing = true;
+            _write_cv.notify_all();
+        }
+        if (_writer.joinable()) { _writer.join(); }
+    }
+
+    void KafkaSpool::append(const Message& msg) {
+        try {
+            _log.append(encode(msg));
+        } catch (const std::runtime_error& e) {
+            _logger->error("Failed to spool message to {}: {}", _options.directory(), e.what());
+            throw PublisherError(std::string("Failed to spool message: ") + e.what());
+        }
+        on_spooled(1);
+    }
+
+    void KafkaSpool::append_async(Message msg) {
+        _queued_messages.fetch_add(1);
+        std::lock_guard<std::mutex> lck(_write_mtx);
+        _write_queue.push_back(std::move(msg));
+        _write_cv.notify_one();
+    }
+
+    void KafkaSpool::on_spooled(std::size_t count) {
+        _spooled_messages.fetch_add(count);
+        if (!_spooling.exchange(true)) { _logger->info("Spooling messages which can't be sent to kafka to {}", _options.directory()); }
+
+        std::lock_guard<std::mutex> lck(_mtx);
+        _pending = true;
+        _cv.notify_one();
+    }
+
+    // Everything queued while previous batch was being flushed is appended with a single flush
+    void KafkaSpool::write_loop() {
+        std::vector<Message> batch;
+        std::vector<std::vector<std::uint8_t>> records;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lck(_write_mtx);
+                _write_cv.wait(lck, [&] { return _closing || !_write_queue.empty(); });
+                if (_write_queue.empty()) { return; }
+                batch.swap(_write_queue);
+            }
+
+            records.clear();
+            for (const Message& msg : batch) {
+                records.push_back(encode(msg));
+            }
+            std::size_t appended = 0;
+            try {
+                appended = _log.append_batch(records);
+            } catch (const std::runtime_error& e) { _logger->error("Failed to spool messages to {}: {}", _options.directory(), e.what()); }
+            if (appended > 0) { on_spooled(appended); }
+            if (appended < batch.size()) {
+                _logger->error("{} messages weren't delivered to kafka and were lost: spool {} is full", batch.size() - appended,
+                               _options.directory());
+            }
+            _queued_messages.fetch_sub(batch.size());
+            batch.clear();
+        }
+    }
+
+    void KafkaSpool::stop() {
+        {
+            std::lock_guard<std::mutex> lck(_mtx);
+            _stopped = true;
+            _cv.notify_all();
+        }
+        if (_drainer.joinable()) { _drainer.join(); }
+    }
+
+    bool KafkaSpool::empty() const {
+        return _queued_messages == 0 && _log.empty();
+    }
+
+    std::vector<std::uint8_t> KafkaSpool::encode(const Message& msg) {
+        std::vector<Header> record_headers;
+        if (msg.record_headers()) { record_headers = msg.record_headers()->to_headers(); }
+
+        std::vector<std::uint8_t> out;
+        out.reserve(3 * sizeof(std::uint32_t) + (msg.key() ? msg.key()->size() : 0) + msg.payload().size());
+        put_u32(out, msg.key() ? static_cast<std::uint32_t>(msg.key()->size()) : NO_KEY);
+        put_u32(out, static_cast<std::uint32_t>(msg.headers().size() + record_headers.size()));
+        if (msg.key()) { put_bytes(out, *msg.key()); }
+        // Own headers go first, so they keep shadowing received headers with the same name after decoding
+        auto put_header = [&](const Header& h) {
+            put_u32(out, static_cast<std::uint32_t>(h.id().name().size()));
+            put_u32(out, static_cast<std::uint32_t>(h.value().size()));
+            put_bytes(out, h.id().name());
+            put_bytes(out, h.value());
+        };
+        for (const Header& h : msg.headers()) {
+            put_header(h);
+        }
+        for (const Header& h : record_headers) {
+            put_header(h);
+        }
+        out.insert(out.end(), msg.payload().begin(), msg.payload().end());
+        return out;
+    }
+
+    Message KafkaSpool::decode(std::span<const std::uint8_t> data) {
+        Reader reader(data);
+        std::uint32_t key_size      = reader.u32();
+        std::uint32_t headers_count = reader.u32();
+
+        std::optional<std::string_view> key;
+        if (key_size != NO_KEY) { key = reader.bytes(key_size); }
+
+        Message::Headers headers;
+        for (std::uint32_t i = 0; i < headers_count; ++i) {
+            std::uint32_t name_size  = reader.u32();
+            std::uint32_t value_size = reader.u32();
+            std::string_view name    = reader.bytes(name_size);
+            headers.add(Header(name, std::string(reader.bytes(value_size))));
+        }
+
+        auto payload = reader.rest();
+        Message msg(std::move(headers), PayloadBuffer(Payload(payload.begin(), payload.end())));
+        if (key) { msg.set_key(std::string(*key)); }
+        return msg;
+    }
+
+    void KafkaSpool::drain_loop() {
+        std::vector<Message> batch;
+        batch.reserve(_options.replay_batch_size());
+
+        while (!stopped()) {
+            batch.clear();
+            std::optional<SegmentLog::Record> last;
+            while (batch.size() < std::max<std::size_t>(_options.replay_batch_size(), 1)) {
+                auto record = _log.read();
+                if (!record) { break; }
+                try {
+                    batch.push_back(decode(record->data()));
+                } catch (const std::invalid_argument& e) {
+                    _logger->error("Dropping corrupted message of spool {}: {}", _options.directory(), e.what());
+                }
+                last = std::move(record);
+            }
+
+            if (!last) {
+                std::unique_lock<std::mutex> lck(_mtx);
+                _cv.wait(lck, [&] { return _stopped || _pending; });
+                if (_stopped) { return; }
+                _pending = false;
+                continue;
+            }
+
+            auto started   = std::chrono::steady_clock::now();
+            bool delivered = false;
+            try {
+                delivered = batch.empty() || _replay(batch);
+            } catch (const std::exception& e) { _logger->error("Failed to replay messages of spool {}: {}", _options.directory(), e.what()); }
+
+            if (!delivered) {
+                _log.rewind();
+                if (!wait_for(std::chrono::steady_clock::now() + _options.retry_backoff())) { return; }
+                continue;
+            }
+
+            _log.commit(*last);
+            _replayed_messages += batch.size();
+            if (_log.empty() && _spooling.exchange(false)) { _logger->info("All messages of spool {} were replayed", _options.directory()); }
+
+            if (_options.replay_rate() > 0) {
+                auto min_duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(
+                    static_cast<double>(batch.size()) / static_cast<double>(_options.replay_rate())));
+                if (!wait_for(started + min_duration)) { return; }
+            }
+        }
+    }
+
+    bool KafkaSpool::stopped() {
+        std::lock_guard<std::mutex> lck(_mtx);
+        return _stopped;
+    }
+
+    bool KafkaSpool::wait_for(std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> lck(_mtx);
+        return !_cv.wait_until(lck, deadline, [&] { return _stopped; });
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "KafkaSpoolOptions.hpp"
+#include "assfire/logger/api/Logger.hpp"
+#include "assfire/messenger/api/Message.hpp"
+#include "assfire/messenger/impl/util/SegmentLog.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace assfire::messenger {
+    // On-disk spool of messages which couldn't be handed to librdkafka or delivered by it.
+    // Messages are appended to a segment log and replayed by a background drainer in batches, in the order they were spooled.
+    // Batch is removed from spool only when all its messages are delivered, otherwise it is replayed again after backoff,
+    // so replay is at-least-once. Messages left in spool directory by previous run are replayed too.
+    // Publisher keeps spooling new messages until spool is empty, so they don't overtake spooled ones
+    class KafkaSpool {
+      public:
+        // Sends messages and waits for their delivery. Returns false if messages have to be replayed again later
+        using ReplayFunction = std::function<bool(std::span<const Message> messages)>;
+
+        // Throws std::runtime_error if spool directory can't be opened
+        KafkaSpool(KafkaSpoolOptions options, ReplayFunction replay);
+        ~KafkaSpool();
+        KafkaSpool(const KafkaSpool& rhs) = delete;
+
+        KafkaSpool& operator=(const KafkaSpool& rhs) = delete;
+
+        // Returns once message is on disk. Throws PublisherError if message is too large or spool is full
+        void append(const Message& msg);
+
+        // Hands message to spool writer and returns without waiting for disk, so messages queued meanwhile are flushed together.
+        // Messages which can't be spooled are logged and lost. Queued messages are written before spool is destroyed
+        void append_async(Message msg);
+
+        // Stops drainer, waiting for the batch being replayed. Messages which weren't replayed stay in spool
+        void stop();
+
+        // True if all spooled messages were replayed and no asynchronously appended message is waiting to be written
+        bool empty() const;
+
+        std::uint64_t spooled_messages() const {
+            return _spooled_messages;
+        }
+
+        std::uint64_t replayed_messages() const {
+            return _replayed_messages;
+        }
+
+        static std::vector<std::uint8_t> encode(const Message& msg);
+        // Throws std::invalid_argument if data isn't an encoded message
+        static Message decode(std::span<const std::uint8_t> data);
+
+      private:
+        void on_spooled(std::size_t count);
+        void write_loop();
+        void drain_loop();
+        bool stopped();
+        // Returns false if spool is stopped before deadline
+        bool wait_for(std::chrono::steady_clock::time_point deadline);
+
+        KafkaSpoolOptions _options;
+        ReplayFunction _replay;
+        SegmentLog _log;
+        std::atomic<std::uint64_t> _spooled_messages;
+        std::atomic<std::uint64_t> _replayed_messages;
+        std::atomic_bool _spooling;
+        std::mutex _mtx;
+        std::condition_variable _cv;
+        bool _stopped = false;
+        bool _pending = false;
+        std::thread _drainer;
+        std::mutex _write_mtx;
+        std::condition_variable _write_cv;
+        std::vector<Message> _write_queue;
+        // Asynchronously appended messages not yet written to log, counted until they are on disk or lost
+        std::atomic<std::size_t> _queued_messages;
+        bool _closing = false;
+        std::thread _writer;
+        std::shared_ptr<logger::Logger> _logger;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
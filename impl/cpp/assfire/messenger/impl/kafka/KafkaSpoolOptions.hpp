@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace assfire::messenger {
+    class KafkaSpoolOptions {
+      public:
+        KafkaSpoolOptions()                             = default;
+        KafkaSpoolOptions(const KafkaSpoolOptions &rhs) = default;
+        KafkaSpoolOptions(KafkaSpoolOptions &&rhs)      = default;
+
+        KafkaSpoolOptions &operator=(const KafkaSpoolOptions &rhs) = default;
+        KafkaSpoolOptions &operator=(KafkaSpoolOptions &&rhs) = default;
+
+        bool operator==(const KafkaSpoolOptions &rhs) const = default;
+
+        std::string to_string() const {
+            return "{directory = " + _directory + ",segment_size = " + std::to_string(_segment_size) + ",max_segments = " +
+                   std::to_string(_max_segments) + ",replay_batch_size = " + std::to_string(_replay_batch_size) +
+                   ",replay_rate = " + std::to_string(_replay_rate) + ",retry_backoff_ms = " + std::to_string(_retry_backoff.count()) + "}";
+        }
+
+        // Directory of spool segment files. Must not be shared by publishers
+        const std::string &directory() const {
+            return _directory;
+        }
+        void set_directory(std::string directory) {
+            _directory = std::move(directory);
+        }
+
+        // Size of every segment file, which also limits size of a spooled message
+        std::size_t segment_size() const {
+            return _segment_size;
+        }
+        void set_segment_size(std::size_t segment_size) {
+            _segment_size = segment_size;
+        }
+
+        // Spooling fails once this many segments hold messages which weren't replayed yet
+        std::size_t max_segments() const {
+            return _max_segments;
+        }
+        void set_max_segments(std::size_t max_segments) {
+            _max_segments = max_segments;
+        }
+
+        // Number of spooled messages sent at once, spool advances only after all of them are delivered
+        std::size_t replay_batch_size() const {
+            return _replay_batch_size;
+        }
+        void set_replay_batch_size(std::size_t replay_batch_size) {
+            _replay_batch_size = replay_batch_size;
+        }
+
+        // Maximum number of replayed messages per second, 0 means unlimited
+        std::size_t replay_rate() const {
+            return _replay_rate;
+        }
+        void set_replay_rate(std::size_t replay_rate) {
+            _replay_rate = replay_rate;
+        }
+
+        // Delay before replaying again after some messages of a batch weren't delivered
+        std::chrono::milliseconds retry_backoff() const {
+            return _retry_backoff;
+        }
+        void set_retry_backoff(std::chrono::milliseconds retry_backoff) {
+            _retry_backoff = retry_backoff;
+        }
+
+      private:
+        std::string _directory;
+        std::size_t _segment_size                = 64 * 1024 * 1024;
+        std::size_t _max_segments                = 16;
+        std::size_t _replay_batch_size           = 1000;
+        std::size_t _replay_rate                 = 10000;
+        std::chrono::milliseconds _retry_backoff = std::chrono::seconds(1);
+    };
+} // namespace assfire::messenger
\ No newline at end of file
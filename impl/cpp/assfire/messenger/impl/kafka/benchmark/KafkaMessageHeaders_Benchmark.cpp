@@ -0,0 +1,46 @@
+#include "assfire/messenger/impl/kafka/KafkaMessageHeaders.hpp"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+using namespace assfire::messenger;
+
+static void KafkaMessageHeaders_EncodeOffset(benchmark::State& state) {
+    uint64_t offset = 1234567890;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode_offset_header(offset++));
+    }
+}
+BENCHMARK(KafkaMessageHeaders_EncodeOffset);
+
+static void KafkaMessageHeaders_DecodeOffset(benchmark::State& state) {
+    std::string value = encode_offset_header(1234567890);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decode_offset_header(value));
+    }
+}
+BENCHMARK(KafkaMessageHeaders_DecodeOffset);
+
+static void KafkaMessageHeaders_EncodePartition(benchmark::State& state) {
+    int32_t partition = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode_partition_header(partition++));
+    }
+}
+BENCHMARK(KafkaMessageHeaders_EncodePartition);
+
+static void KafkaMessageHeaders_DecodePartition(benchmark::State& state) {
+    std::string value = encode_partition_header(42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decode_partition_header(value));
+    }
+}
+BENCHMARK(KafkaMessageHeaders_DecodePartition);
+
+static void KafkaMessageHeaders_EncodeDeliveryMetadata(benchmark::State& state) {
+    DeliveryMetadata metadata(std::make_shared<const std::string>("topic1"), 3, 1234567890, std::nullopt);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encode_kafka_headers(metadata));
+    }
+}
+BENCHMARK(KafkaMessageHeaders_EncodeDeliveryMetadata);
\ No newline at end of file
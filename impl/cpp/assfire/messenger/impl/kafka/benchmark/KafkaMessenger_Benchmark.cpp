@@ -0,0 +1,181 @@
+#include "absl/strings/str_split.h"
+#include "assfire/logger/impl/spdlog/SpdlogLoggerFactory.hpp"
+#include "assfire/messenger/api/benchmark/BenchmarkMessage.pb.h"
+#include "assfire/messenger/impl/kafka/KafkaMessenger.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <librdkafka/rdkafka_mock.h>
+#include <string>
+#include <vector>
+
+using namespace assfire::messenger;
+using assfire::messenger::benchmarks::BenchmarkMessage;
+using namespace std::chrono_literals;
+
+namespace {
+    // Same librdkafka mock cluster as used by KafkaMessenger tests, created per benchmark run
+    class MockCluster {
+      public:
+        explicit MockCluster(const std::string& topic) {
+            static bool logger_registered = (assfire::logger::SpdlogLoggerFactory::register_static_factory(), true);
+            (void) logger_registered;
+
+            char errstr[256];
+            _kafka_instance = rd_kafka_new(RD_KAFKA_PRODUCER, rd_kafka_conf_new(), errstr, sizeof(errstr));
+            _mock_cluster   = rd_kafka_mock_cluster_new(_kafka_instance, 3);
+            rd_kafka_mock_topic_create(_mock_cluster, topic.c_str(), 3, 1);
+            _servers = absl::StrSplit(rd_kafka_mock_cluster_bootstraps(_mock_cluster), ",");
+        }
+
+        ~MockCluster() {
+            rd_kafka_mock_cluster_destroy(_mock_cluster);
+            rd_kafka_destroy(_kafka_instance);
+        }
+
+        const std::vector<std::string>& servers() const {
+            return _servers;
+        }
+
+      private:
+        rd_kafka_t* _kafka_instance;
+        rd_kafka_mock_cluster_t* _mock_cluster;
+        std::vector<std::string> _servers;
+    };
+
+    void declare_channels(KafkaMessenger& messenger, const MockCluster& cluster, const std::string& topic) {
+        KafkaPublisherOptions publisher_opts;
+        publisher_opts.set_bootstrap_servers(cluster.servers());
+        publisher_opts.set_topic_name(topic);
+        publisher_opts.set_linger_ms(0);
+        messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+        KafkaConsumerOptions consumer_opts;
+        consumer_opts.set_bootstrap_servers(cluster.servers());
+        consumer_opts.set_topic_name(topic);
+        messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+    }
+
+    void set_percentile_counters(benchmark::State& state, std::vector<double>& latencies_us) {
+        if (latencies_us.empty()) { return; }
+        std::sort(latencies_us.begin(), latencies_us.end());
+        auto percentile = [&](double p) {
+            return latencies_us[std::min(latencies_us.size() - 1, static_cast<std::size_t>(p * latencies_us.size()))];
+        };
+        state.counters["p50_us"] = percentile(0.50);
+        state.counters["p99_us"] = percentile(0.99);
+    }
+} // namespace
+
+static void KafkaMessenger_GetPublisher(benchmark::State& state) {
+    MockCluster cluster("lookup");
+    KafkaMessenger messenger;
+    declare_channels(messenger, cluster, "lookup");
+    ChannelId channel_id("pub1");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(messenger.get_publisher(channel_id));
+    }
+}
+BENCHMARK(KafkaMessenger_GetPublisher);
+
+static void KafkaMessenger_GetConsumer(benchmark::State& state) {
+    MockCluster cluster("lookup");
+    KafkaMessenger messenger;
+    declare_channels(messenger, cluster, "lookup");
+    ChannelId channel_id("cons1");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(messenger.get_consumer(channel_id));
+    }
+}
+BENCHMARK(KafkaMessenger_GetConsumer);
+
+// Publishes a single message and waits until it is consumed, so each iteration is one full round trip
+static void KafkaMessenger_RoundTripLatency(benchmark::State& state) {
+    MockCluster cluster("latency");
+    KafkaMessenger messenger;
+    declare_channels(messenger, cluster, "latency");
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    // First message waits for consumer group join and partition assignment, it isn't measured
+    publisher->publish(Message(pack("warmup")));
+    consumer->poll(30s);
+
+    Message msg(pack(std::string(state.range(0), 'x')));
+    std::vector<double> latencies_us;
+    for (auto _ : state) {
+        auto started_at = std::chrono::steady_clock::now();
+        publisher->publish(msg);
+        benchmark::DoNotOptimize(consumer->poll(30s));
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started_at).count());
+    }
+    set_percentile_counters(state, latencies_us);
+}
+BENCHMARK(KafkaMessenger_RoundTripLatency)->Arg(64)->Arg(4096)->Iterations(1000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Publishes a batch and consumes all its messages, reporting messages per second
+static void KafkaMessenger_Throughput(benchmark::State& state) {
+    MockCluster cluster("throughput");
+    KafkaMessenger messenger;
+    declare_channels(messenger, cluster, "throughput");
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    publisher->publish(Message(pack("warmup")));
+    consumer->poll(30s);
+
+    std::vector<Message> batch(state.range(0), Message(pack(std::string(256, 'x'))));
+    std::vector<Message> received;
+    received.reserve(batch.size());
+    for (auto _ : state) {
+        publisher->publish_batch(batch);
+        received.clear();
+        while (received.size() < batch.size()) {
+            consumer->poll_batch(received, batch.size() - received.size(), 30s);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(KafkaMessenger_Throughput)->Arg(1000)->Iterations(20)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Publishes a batch of protobufs and consumes them. Proto path serializes straight into buffer passed to librdkafka,
+// message path packs proto into a payload which librdkafka copies
+static void KafkaMessenger_PublishProto(benchmark::State& state) {
+    MockCluster cluster("proto");
+    KafkaMessenger messenger;
+    declare_channels(messenger, cluster, "proto");
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    publisher->publish(Message(pack("warmup")));
+    consumer->poll(30s);
+
+    constexpr std::size_t batch_size = 100;
+    BenchmarkMessage proto;
+    proto.set_description(std::string(state.range(1), 'x'));
+    std::vector<Message> received;
+    received.reserve(batch_size);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            if (state.range(0) != 0) {
+                publisher->publish(proto);
+            } else {
+                publisher->publish(Message(proto));
+            }
+        }
+        received.clear();
+        while (received.size() < batch_size) {
+            consumer->poll_batch(received, batch_size - received.size(), 30s);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+    state.SetBytesProcessed(state.iterations() * batch_size * state.range(1));
+}
+BENCHMARK(KafkaMessenger_PublishProto)
+    ->ArgsProduct({{0, 1}, {4096, 256 * 1024}})
+    ->ArgNames({"serialized", "size"})
+    ->Iterations(20)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "assfire/messenger/impl/kafka/KafkaCompressionSelector.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+using Codec = KafkaOptions::CompressionTypeEnum;
+
+namespace {
+    // Compresses payloads by given factor, taking at least given time to do it
+    class FakeProbe : public KafkaCodecProbe {
+      public:
+        FakeProbe(double ratio, std::chrono::microseconds cost = 0us) : _ratio(ratio), _cost(cost) {}
+
+        virtual std::size_t compressed_size(std::span<const std::uint8_t> payload, std::optional<std::int32_t> level) const override {
+            if (_cost.count() > 0) { std::this_thread::sleep_for(_cost); }
+            return static_cast<std::size_t>(payload.size() / _ratio);
+        }
+
+      private:
+        double _ratio;
+        std::chrono::microseconds _cost;
+    };
+
+    KafkaAdaptiveCompressionOptions adaptive_options(KafkaAdaptiveCompressionOptions::Probes probes) {
+        KafkaAdaptiveCompressionOptions options;
+        options.set_sample_interval(1);
+        options.set_sample_window(10);
+        options.set_probes(std::move(probes));
+        return options;
+    }
+
+    std::optional<Codec> sample_window(KafkaCompressionSelector& selector, std::span<const std::uint8_t> payload, std::size_t count = 10) {
+        std::optional<Codec> result;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (auto codec = selector.sample(payload)) {
+                EXPECT_FALSE(result);
+                result = codec;
+            }
+        }
+        return result;
+    }
+} // namespace
+
+TEST(KafkaCompressionSelector, ChoosesCodecSavingMostBytes) {
+    KafkaCompressionSelector selector(
+        adaptive_options({{Codec::GZIP, std::make_shared<FakeProbe>(4.0)}, {Codec::LZ4, std::make_shared<FakeProbe>(2.0)}}),
+        Codec::NONE, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    EXPECT_EQ(sample_window(selector, payload, 9), std::nullopt);
+    EXPECT_FALSE(selector.stats().selected());
+    EXPECT_EQ(sample_window(selector, payload, 1), Codec::GZIP);
+
+    KafkaCompressionStats stats = selector.stats();
+    EXPECT_TRUE(stats.selected());
+    EXPECT_EQ(stats.codec(), Codec::GZIP);
+    EXPECT_EQ(stats.sampled_messages(), 10);
+    ASSERT_TRUE(stats.ratio());
+    EXPECT_DOUBLE_EQ(*stats.ratio(), 4.0);
+}
+
+TEST(KafkaCompressionSelector, SkipsCodecsNotWorthTheirCpuCost) {
+    KafkaAdaptiveCompressionOptions options = adaptive_options(
+        {{Codec::ZSTD, std::make_shared<FakeProbe>(8.0, 2ms)}, {Codec::LZ4, std::make_shared<FakeProbe>(2.0)}});
+    options.set_min_saved_bytes_per_cpu_us(100);
+    KafkaCompressionSelector selector(options, Codec::NONE, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    EXPECT_EQ(sample_window(selector, payload), Codec::LZ4);
+}
+
+TEST(KafkaCompressionSelector, DisablesCompressionWhenNothingPaysOff) {
+    KafkaCompressionSelector selector(adaptive_options({{Codec::GZIP, std::make_shared<FakeProbe>(1.0)}}), Codec::GZIP, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    EXPECT_EQ(sample_window(selector, payload), Codec::NONE);
+    EXPECT_EQ(selector.stats().codec(), Codec::NONE);
+    EXPECT_EQ(selector.stats().ratio(), std::nullopt);
+}
+
+TEST(KafkaCompressionSelector, KeepsCurrentCodecIfItIsChosen) {
+    KafkaCompressionSelector selector(adaptive_options({{Codec::GZIP, std::make_shared<FakeProbe>(3.0)}}), Codec::GZIP, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    EXPECT_EQ(sample_window(selector, payload), std::nullopt);
+    EXPECT_TRUE(selector.stats().selected());
+    EXPECT_EQ(selector.stats().codec(), Codec::GZIP);
+}
+
+TEST(KafkaCompressionSelector, ChoosesCodecOnlyOnce) {
+    auto compressible = std::make_shared<FakeProbe>(4.0);
+    KafkaCompressionSelector selector(adaptive_options({{Codec::GZIP, compressible}}), Codec::NONE, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    EXPECT_EQ(sample_window(selector, payload), Codec::GZIP);
+    EXPECT_EQ(sample_window(selector, payload, 100), std::nullopt);
+    EXPECT_EQ(selector.stats().sampled_messages(), 110);
+    EXPECT_DOUBLE_EQ(*selector.stats().ratio(), 4.0);
+}
+
+TEST(KafkaCompressionSelector, ChoosesCodecAgainAfterReselectionInterval) {
+    auto ratio = std::make_shared<std::atomic<double>>(4.0);
+    class VaryingProbe : public KafkaCodecProbe {
+      public:
+        explicit VaryingProbe(std::shared_ptr<std::atomic<double>> ratio) : _ratio(std::move(ratio)) {}
+
+        virtual std::size_t compressed_size(std::span<const std::uint8_t> payload, std::optional<std::int32_t> level) const override {
+            return static_cast<std::size_t>(payload.size() / _ratio->load());
+        }
+
+      private:
+        std::shared_ptr<std::atomic<double>> _ratio;
+    };
+    KafkaAdaptiveCompressionOptions options = adaptive_options({{Codec::GZIP, std::make_shared<VaryingProbe>(ratio)}});
+    options.set_reselection_interval(20);
+    KafkaCompressionSelector selector(options, Codec::NONE, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    EXPECT_EQ(sample_window(selector, payload), Codec::GZIP);
+    ratio->store(1.0);
+    EXPECT_EQ(sample_window(selector, payload, 20), std::nullopt);
+    EXPECT_EQ(sample_window(selector, payload), Codec::NONE);
+    EXPECT_EQ(selector.stats().codec(), Codec::NONE);
+    EXPECT_EQ(selector.stats().sampled_messages(), 40);
+}
+
+TEST(KafkaCompressionSelector, SamplesEveryIntervalMessage) {
+    KafkaAdaptiveCompressionOptions options = adaptive_options({{Codec::GZIP, std::make_shared<FakeProbe>(4.0)}});
+    options.set_sample_interval(10);
+    KafkaCompressionSelector selector(options, Codec::NONE, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    EXPECT_EQ(sample_window(selector, payload, 90), std::nullopt);
+    EXPECT_EQ(selector.stats().sampled_messages(), 9);
+    EXPECT_EQ(sample_window(selector, payload, 10), Codec::GZIP);
+}
+
+TEST(KafkaCompressionSelector, ConcurrentSamplesAreProbedInParallel) {
+    KafkaCompressionSelector selector(adaptive_options({{Codec::GZIP, std::make_shared<FakeProbe>(4.0, 100ms)}}), Codec::NONE, std::nullopt);
+    std::vector<std::uint8_t> payload(4096, 'a');
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] { selector.sample(payload); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 300ms);
+    EXPECT_EQ(selector.stats().sampled_messages(), 4);
+}
+
+TEST(KafkaCompressionSelector, GzipProbeMeasuresCompressibility) {
+    KafkaGzipProbe probe;
+    std::vector<std::uint8_t> repetitive(64 * 1024, 'a');
+    std::vector<std::uint8_t> random(64 * 1024);
+    std::mt19937 rng(42);
+    for (auto& b : random) {
+        b = static_cast<std::uint8_t>(rng());
+    }
+
+    EXPECT_LT(probe.compressed_size(repetitive, std::nullopt), repetitive.size() / 100);
+    EXPECT_LT(probe.compressed_size(repetitive, 9), repetitive.size() / 100);
+    EXPECT_GE(probe.compressed_size(random, 1), random.size());
+}
+
+TEST(KafkaCompressionSelector, Lz4ProbeMeasuresCompressibility) {
+    KafkaLz4Probe probe;
+    std::vector<std::uint8_t> repetitive(256 * 1024, 'a');
+    std::vector<std::uint8_t> random(256 * 1024);
+    std::mt19937 rng(42);
+    for (auto& b : random) {
+        b = static_cast<std::uint8_t>(rng());
+    }
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "{\"id\":" + std::to_string(i) + ",\"status\":\"delivered\",\"route\":\"warehouse-to-customer\"}";
+    }
+    std::span<const std::uint8_t> text_payload(reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+
+    EXPECT_LT(probe.compressed_size(repetitive, std::nullopt), repetitive.size() / 100);
+    EXPECT_GE(probe.compressed_size(random, std::nullopt), random.size());
+    EXPECT_LT(probe.compressed_size(random, std::nullopt), random.size() + 64);
+    EXPECT_LT(probe.compressed_size(text_payload, std::nullopt), text.size() / 3);
+    EXPECT_GT(probe.compressed_size(text_payload, std::nullopt), KafkaGzipProbe().compressed_size(text_payload, std::nullopt));
+    EXPECT_EQ(probe.compressed_size({}, std::nullopt), 11);
+}
+
+TEST(KafkaCompressionSelector, DefaultOptionsChooseGzipForCompressiblePayloads) {
+    KafkaAdaptiveCompressionOptions options;
+    options.set_sample_interval(1);
+    KafkaCompressionSelector selector(options, Codec::NONE, std::nullopt);
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "{\"id\":" + std::to_string(i) + ",\"status\":\"delivered\",\"route\":\"warehouse-to-customer\"}";
+    }
+    std::span<const std::uint8_t> payload(reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+
+    EXPECT_EQ(sample_window(selector, payload, options.sample_window()), Codec::GZIP);
+    EXPECT_GT(*selector.stats().ratio(), 5.0);
+    EXPECT_EQ(KafkaAdaptiveCompressionOptions(), KafkaAdaptiveCompressionOptions());
+}
\ No newline at end of file
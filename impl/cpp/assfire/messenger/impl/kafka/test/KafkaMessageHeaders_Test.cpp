@@ -18,4 +18,16 @@ TEST(KafkaMessageHeaders, OffsetHeaderIsEncodedAndDecodedCorrectly) {
     auto dec        = decode_offset_header(enc);
 
     EXPECT_EQ(dec, 5);
+}
+
+TEST(KafkaMessageHeaders, DeliveryMetadataIsEncodedAsHeaders) {
+    DeliveryMetadata metadata(std::make_shared<const std::string>("topic1"), 3, 42);
+    auto headers = encode_kafka_headers(metadata);
+
+    ASSERT_EQ(headers.size(), 3);
+    EXPECT_EQ(headers[0], Header(KAFKA_HEADER_OFFSET, "42"));
+    EXPECT_EQ(headers[1], Header(KAFKA_HEADER_TOPIC_NAME, "topic1"));
+    EXPECT_EQ(headers[2], Header(KAFKA_HEADER_TOPIC_PARTITION, "3"));
+    EXPECT_EQ(decode_offset_header(headers[0].value()), 42);
+    EXPECT_EQ(decode_partition_header(headers[2].value()), 3);
 }
\ No newline at end of file
@@ -1,18 +1,46 @@
 #include "absl/strings/str_split.h"
 #include "assfire/logger/impl/spdlog/SpdlogLoggerFactory.hpp"
+#include "assfire/messenger/api/AsyncConsumer.hpp"
+#include "assfire/messenger/api/AsyncPublisher.hpp"
 #include "assfire/messenger/api/Exceptions.hpp"
-#include "assfire/messenger/impl/kafka/KafkaExceptions.hpp"
+#include "assfire/messenger/api/benchmark/BenchmarkMessage.pb.h"
 #include "assfire/messenger/impl/kafka/KafkaMessageHeaders.hpp"
 #include "assfire/messenger/impl/kafka/KafkaMessenger.hpp"
 
+#include <algorithm>
+#include <filesystem>
+#include <future>
 #include <gtest/gtest.h>
 #include <librdkafka/rdkafka_mock.h>
+#include <unistd.h>
 
 using namespace assfire::messenger;
 using namespace testing;
 using namespace std::chrono_literals;
 
 using KafkaMessage = assfire::messenger::Message;
+using assfire::messenger::benchmarks::BenchmarkMessage;
+
+namespace {
+    // Coroutine which starts eagerly and is destroyed on completion
+    struct DetachedTask {
+        struct promise_type {
+            DetachedTask get_return_object() {
+                return {};
+            }
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+            void return_void() {}
+            void unhandled_exception() {
+                std::terminate();
+            }
+        };
+    };
+} // namespace
 
 class KafkaMessengerTest : public ::testing::Test {
   protected:
@@ -82,17 +110,235 @@ TEST_F(KafkaMessengerTest, Messenger_MessagesAreSentAndReceivedOverTopic) {
     EXPECT_TRUE(messages.contains("Test message 2"));
     EXPECT_TRUE(messages.contains("Test message 3"));
 
-    EXPECT_EQ(received_msg1.header(KAFKA_HEADER_TOPIC_NAME), "topic1");
-    EXPECT_TRUE(received_msg1.header(KAFKA_HEADER_OFFSET));
-    EXPECT_TRUE(received_msg1.header(KAFKA_HEADER_TOPIC_PARTITION));
+    ASSERT_TRUE(received_msg1.delivery_metadata());
+    EXPECT_EQ(received_msg1.delivery_metadata()->topic(), "topic1");
+    EXPECT_TRUE(received_msg1.delivery_metadata()->timestamp());
 
-    EXPECT_EQ(received_msg2.header(KAFKA_HEADER_TOPIC_NAME), "topic1");
-    EXPECT_TRUE(received_msg2.header(KAFKA_HEADER_OFFSET));
-    EXPECT_TRUE(received_msg2.header(KAFKA_HEADER_TOPIC_PARTITION));
+    ASSERT_TRUE(received_msg2.delivery_metadata());
+    EXPECT_EQ(received_msg2.delivery_metadata()->topic(), "topic1");
+    EXPECT_TRUE(received_msg2.delivery_metadata()->timestamp());
 
-    EXPECT_EQ(received_msg3.header(KAFKA_HEADER_TOPIC_NAME), "topic1");
-    EXPECT_TRUE(received_msg3.header(KAFKA_HEADER_OFFSET));
-    EXPECT_TRUE(received_msg3.header(KAFKA_HEADER_TOPIC_PARTITION));
+    ASSERT_TRUE(received_msg3.delivery_metadata());
+    EXPECT_EQ(received_msg3.delivery_metadata()->topic(), "topic1");
+    EXPECT_TRUE(received_msg3.delivery_metadata()->timestamp());
+
+    EXPECT_EQ(received_msg1.delivery_metadata()->topic_handle(), received_msg2.delivery_metadata()->topic_handle());
+
+    EXPECT_NO_THROW(consumer->ack(received_msg1));
+    EXPECT_NO_THROW(consumer->ack(received_msg2));
+    EXPECT_NO_THROW(consumer->ack(received_msg3));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_MessageWithoutDeliveryMetadataCannotBeAcked) {
+    KafkaMessenger messenger;
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto consumer = messenger.get_consumer(ChannelId("cons1"));
+
+    EXPECT_THROW(consumer->ack(KafkaMessage(pack("Test message 1"))), AckFailedError);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_CoalescedAcksAreCommittedOnStop) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    consumer_opts.set_ack_mode(KafkaAckMode::COALESCED);
+    consumer_opts.set_commit_interval(1h);
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+
+    publisher->publish(KafkaMessage(pack("Test message 1")));
+    publisher->publish(KafkaMessage(pack("Test message 2")));
+    publisher->publish(KafkaMessage(pack("Test message 3")));
+
+    EXPECT_NO_THROW(consumer->ack(consumer->poll(30s)));
+    EXPECT_NO_THROW(consumer->ack(consumer->poll(30s)));
+    EXPECT_NO_THROW(consumer->ack(consumer->poll(30s)));
+
+    EXPECT_EQ(consumer->commit_stats().commits(), 0);
+
+    consumer->stop();
+
+    KafkaCommitStats stats = consumer->commit_stats();
+    EXPECT_GE(stats.commits(), 1);
+    EXPECT_EQ(stats.failures(), 0);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_MessagesAreReceivedInBatches) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    publisher->publish(KafkaMessage(pack("Test message 1")));
+    publisher->publish(KafkaMessage(pack("Test message 2")));
+    publisher->publish(KafkaMessage(pack("Test message 3")));
+
+    std::vector<KafkaMessage> received;
+    while (received.size() < 3) {
+        std::size_t polled = consumer->poll_batch(received, 3 - received.size(), 30s);
+        EXPECT_GT(polled, 0);
+    }
+
+    std::unordered_set<std::string> messages;
+    for (const auto& msg : received) {
+        messages.emplace(to_string_view(msg.payload()));
+    }
+
+    EXPECT_EQ(received.size(), 3);
+    EXPECT_TRUE(messages.contains("Test message 1"));
+    EXPECT_TRUE(messages.contains("Test message 2"));
+    EXPECT_TRUE(messages.contains("Test message 3"));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_BatchIsPublishedAndReceived) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    std::vector<KafkaMessage> batch {KafkaMessage(pack("Test message 1")), KafkaMessage(pack("Test message 2")),
+                                     KafkaMessage(pack("Test message 3"))};
+    PublishBatchResult result = publisher->publish_batch(batch);
+
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(result.total(), 3);
+    EXPECT_EQ(result.published(), 3);
+
+    std::unordered_set<std::string> messages;
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+
+    EXPECT_TRUE(messages.contains("Test message 1"));
+    EXPECT_TRUE(messages.contains("Test message 2"));
+    EXPECT_TRUE(messages.contains("Test message 3"));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_DeliveryIsReportedForAsyncPublish) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+
+    std::future<DeliveryReport> delivery1 = publisher->publish_async(KafkaMessage(pack("Test message 1")));
+    std::future<DeliveryReport> delivery2 = publisher->publish_async(KafkaMessage(pack("Test message 2")));
+
+    ASSERT_EQ(delivery1.wait_for(30s), std::future_status::ready);
+    ASSERT_EQ(delivery2.wait_for(30s), std::future_status::ready);
+
+    DeliveryReport report1 = delivery1.get();
+    DeliveryReport report2 = delivery2.get();
+
+    EXPECT_TRUE(report1.ok());
+    EXPECT_TRUE(report1.partition());
+    EXPECT_TRUE(report1.offset());
+
+    EXPECT_TRUE(report2.ok());
+    EXPECT_TRUE(report2.partition());
+    EXPECT_TRUE(report2.offset());
+}
+
+TEST_F(KafkaMessengerTest, Messenger_AllMessagesAreReceivedWhenPrefetchIsBounded) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    consumer_opts.set_max_poll_records(1);
+    consumer_opts.set_prefetch_high_watermark_messages(1);
+    consumer_opts.set_prefetch_high_watermark_bytes(16);
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    publisher->publish(KafkaMessage(pack("Test message 1")));
+    publisher->publish(KafkaMessage(pack("Test message 2")));
+    publisher->publish(KafkaMessage(pack("Test message 3")));
+
+    std::unordered_set<std::string> messages;
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+
+    EXPECT_TRUE(messages.contains("Test message 1"));
+    EXPECT_TRUE(messages.contains("Test message 2"));
+    EXPECT_TRUE(messages.contains("Test message 3"));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_HeadersAreSentAsKafkaRecordHeaders) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    KafkaMessage msg(pack("Test message 1"));
+    msg.add_header(Header("tenant", "tenant-1"));
+    msg.add_header(Header("content-type", "text/plain"));
+    publisher->publish(msg);
+
+    KafkaMessage received_msg = consumer->poll(30s);
+
+    EXPECT_EQ(to_string_view(received_msg.payload()), "Test message 1");
+    EXPECT_TRUE(received_msg.headers().empty());
+    EXPECT_EQ(received_msg.header("tenant"), "tenant-1");
+    EXPECT_EQ(received_msg.header(HeaderId("content-type")), "text/plain");
+    EXPECT_EQ(received_msg.header_view("content-type"), "text/plain");
+    EXPECT_FALSE(received_msg.header_view("trace-id"));
+    ASSERT_TRUE(received_msg.record_headers());
+    EXPECT_EQ(received_msg.record_headers()->to_headers().size(), 2);
 }
 
 TEST_F(KafkaMessengerTest, Messenger_PollingIsInterruptedOnTimeout) {
@@ -157,3 +403,533 @@ TEST_F(KafkaMessengerTest, Messenger_ChannelIsReusedOnTryingToCreateWithSameOpti
     EXPECT_EQ(consumer.get(), consumer2.get());
 }
 
+TEST_F(KafkaMessengerTest, Messenger_MessagesAreReceivedWithSpinThenParkWakeup) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    consumer_opts.set_wakeup_mode(KafkaWakeupMode::SPIN_THEN_PARK);
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    EXPECT_THROW(consumer->poll(100ms), TimeoutError);
+
+    publisher->publish(KafkaMessage(pack("Test message 1")));
+    publisher->publish(KafkaMessage(pack("Test message 2")));
+
+    std::unordered_set<std::string> messages;
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+    messages.emplace(to_string_view(consumer->poll(30s).payload()));
+
+    EXPECT_TRUE(messages.contains("Test message 1"));
+    EXPECT_TRUE(messages.contains("Test message 2"));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_MessagesWithSameHeaderAreSentToSamePartition) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    publisher_opts.set_custom_partitioner(std::make_shared<HeaderHashPartitioner>(HeaderId("tenant")));
+    auto kafka_publisher = messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    // Partitions count is fetched in background, messages published before that are partitioned by librdkafka
+    auto deadline = std::chrono::steady_clock::now() + 30s;
+    while (kafka_publisher->partitions_count() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+    }
+    ASSERT_GT(kafka_publisher->partitions_count(), 0);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+    auto consumer  = messenger.get_consumer(ChannelId("cons1"));
+
+    for (int i = 0; i < 3; ++i) {
+        KafkaMessage msg(pack("Test message " + std::to_string(i)));
+        msg.set_key("entity-" + std::to_string(i));
+        msg.add_header(Header("tenant", "tenant-1"));
+        publisher->publish(msg);
+    }
+
+    std::unordered_set<std::string> keys;
+    std::unordered_set<std::int32_t> partitions;
+    for (int i = 0; i < 3; ++i) {
+        KafkaMessage received_msg = consumer->poll(30s);
+        ASSERT_TRUE(received_msg.key());
+        ASSERT_TRUE(received_msg.delivery_metadata());
+        keys.insert(*received_msg.key());
+        partitions.insert(received_msg.delivery_metadata()->partition());
+    }
+
+    EXPECT_EQ(keys, std::unordered_set<std::string>({"entity-0", "entity-1", "entity-2"}));
+    EXPECT_EQ(partitions.size(), 1);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_MessagesAreHandledByWorkersInPartitionOrder) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    consumer_opts.set_worker_count(4);
+    consumer_opts.set_ack_mode(KafkaAckMode::COALESCED);
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+
+    constexpr int messages_count = 20;
+    std::mutex mtx;
+    std::condition_variable handled_cv;
+    std::unordered_map<std::int32_t, std::vector<std::int64_t>> offsets;
+    int handled = 0;
+
+    consumer->start_workers([&](const KafkaMessage& msg) {
+        std::lock_guard<std::mutex> lck(mtx);
+        offsets[msg.delivery_metadata()->partition()].push_back(msg.delivery_metadata()->offset());
+        ++handled;
+        handled_cv.notify_all();
+    });
+
+    for (int i = 0; i < messages_count; ++i) {
+        publisher->publish(KafkaMessage(pack("Test message " + std::to_string(i))));
+    }
+
+    {
+        std::unique_lock<std::mutex> lck(mtx);
+        ASSERT_TRUE(handled_cv.wait_for(lck, 30s, [&] { return handled == messages_count; }));
+        for (const auto& [partition, partition_offsets] : offsets) {
+            EXPECT_TRUE(std::is_sorted(partition_offsets.begin(), partition_offsets.end()));
+        }
+    }
+
+    consumer->stop();
+    EXPECT_GE(consumer->commit_stats().commits(), 1);
+    EXPECT_EQ(consumer->commit_stats().failures(), 0);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_SubscribedHandlerReceivesMessages) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto publisher = messenger.get_publisher(ChannelId("pub1"));
+
+    constexpr int concurrency = 2;
+    std::mutex mtx;
+    std::condition_variable handled_cv;
+    std::unordered_set<std::string> messages;
+    std::atomic<int> running(0);
+    std::atomic<int> max_running(0);
+
+    messenger.subscribe(
+        ChannelId("cons1"),
+        [&](const KafkaMessage& msg) {
+            int now_running = running.fetch_add(1) + 1;
+            max_running     = std::max(max_running.load(), now_running);
+            std::this_thread::sleep_for(10ms);
+            running.fetch_sub(1);
+
+            std::lock_guard<std::mutex> lck(mtx);
+            messages.emplace(to_string_view(msg.payload()));
+            handled_cv.notify_all();
+        },
+        concurrency);
+
+    publisher->publish(KafkaMessage(pack("Test message 1")));
+    publisher->publish(KafkaMessage(pack("Test message 2")));
+    publisher->publish(KafkaMessage(pack("Test message 3")));
+
+    std::unique_lock<std::mutex> lck(mtx);
+    ASSERT_TRUE(handled_cv.wait_for(lck, 30s, [&] { return messages.size() == 3; }));
+    EXPECT_TRUE(messages.contains("Test message 1"));
+    EXPECT_TRUE(messages.contains("Test message 2"));
+    EXPECT_TRUE(messages.contains("Test message 3"));
+    EXPECT_LE(max_running.load(), concurrency);
+
+    lck.unlock();
+    messenger.get_consumer(ChannelId("cons1"))->stop();
+}
+
+TEST_F(KafkaMessengerTest, Messenger_MessagesArePublishedAndReceivedByCoroutines) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    AsyncPublisher publisher(messenger.get_publisher(ChannelId("pub1")), inline_executor());
+    AsyncConsumer consumer(messenger.get_consumer(ChannelId("cons1")), inline_executor());
+
+    std::promise<std::vector<std::string>> received;
+    auto consume = [&]() -> DetachedTask {
+        std::vector<std::string> messages;
+        KafkaMessage msg = co_await consumer.next();
+        messages.emplace_back(to_string_view(msg.payload()));
+        while (messages.size() < 3) {
+            for (const KafkaMessage& batch_msg : co_await consumer.next_batch(2)) {
+                messages.emplace_back(to_string_view(batch_msg.payload()));
+            }
+        }
+        received.set_value(std::move(messages));
+    };
+    consume();
+
+    std::promise<std::vector<DeliveryReport>> delivered;
+    auto publish = [&]() -> DetachedTask {
+        std::vector<DeliveryReport> reports;
+        reports.push_back(co_await publisher.publish_async(KafkaMessage(pack("Test message 1"))));
+        reports.push_back(co_await publisher.publish_async(KafkaMessage(pack("Test message 2"))));
+        reports.push_back(co_await publisher.publish_async(KafkaMessage(pack("Test message 3"))));
+        delivered.set_value(std::move(reports));
+    };
+    publish();
+
+    auto delivered_ftr = delivered.get_future();
+    ASSERT_EQ(delivered_ftr.wait_for(30s), std::future_status::ready);
+    for (const DeliveryReport& report : delivered_ftr.get()) {
+        EXPECT_TRUE(report.ok());
+    }
+
+    auto received_ftr = received.get_future();
+    ASSERT_EQ(received_ftr.wait_for(30s), std::future_status::ready);
+    std::vector<std::string> messages = received_ftr.get();
+    EXPECT_EQ(std::unordered_set<std::string>(messages.begin(), messages.end()),
+              std::unordered_set<std::string>({"Test message 1", "Test message 2", "Test message 3"}));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_StatisticsAreCollectedPerChannel) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    publisher_opts.set_statistics_interval_ms(100);
+    auto publisher = messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    consumer_opts.set_statistics_interval_ms(100);
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    publisher->publish(KafkaMessage(pack("Test message 1")));
+    EXPECT_EQ(to_string_view(consumer->poll(30s).payload()), "Test message 1");
+
+    auto deadline = std::chrono::steady_clock::now() + 30s;
+    while ((!consumer->metrics() || !publisher->metrics()) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(50ms);
+    }
+
+    ASSERT_TRUE(publisher->metrics());
+    ASSERT_TRUE(consumer->metrics());
+    EXPECT_FALSE(publisher->metrics()->brokers.empty());
+
+    KafkaMessengerMetrics metrics = messenger.metrics();
+    EXPECT_TRUE(metrics.publishers.contains("pub1"));
+    EXPECT_TRUE(metrics.consumers.contains("cons1"));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_LatenciesOfPolledMessagesAreRecorded) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    auto publisher = messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    publisher->publish(KafkaMessage(pack("Test message 1")));
+    publisher->publish(KafkaMessage(pack("Test message 2")));
+
+    KafkaMessage msg = consumer->poll(30s);
+    ASSERT_TRUE(msg.delivery_metadata()->received_at());
+    consumer->poll(30s);
+
+    KafkaLatencyStats stats = consumer->latency_stats();
+    EXPECT_EQ(stats.broker_to_enqueue().count(), 2);
+    EXPECT_EQ(stats.enqueue_to_dequeue().count(), 2);
+    EXPECT_LE(stats.enqueue_to_dequeue().percentile(50), stats.enqueue_to_dequeue().max());
+}
+
+TEST_F(KafkaMessengerTest, Messenger_MessagesOverflowingProducerQueueAreSpooledAndReplayed) {
+    KafkaMessenger messenger;
+
+    std::string spool_directory = (std::filesystem::temp_directory_path() / ("assfire_kafka_spool_test." + std::to_string(getpid()))).string();
+    std::filesystem::remove_all(spool_directory);
+
+    KafkaSpoolOptions spool_opts;
+    spool_opts.set_directory(spool_directory);
+    spool_opts.set_segment_size(64 * 1024);
+    spool_opts.set_replay_batch_size(1);
+    spool_opts.set_retry_backoff(10ms);
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    publisher_opts.set_queue_buffering_max_messages(1);
+    publisher_opts.set_linger_ms(100);
+    publisher_opts.set_spool(spool_opts);
+    auto publisher = messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    constexpr int count = 20;
+    for (int i = 0; i < count; ++i) {
+        publisher->publish(KafkaMessage(pack("Test message " + std::to_string(i))));
+    }
+    EXPECT_GT(publisher->spool()->spooled_messages(), 0);
+
+    std::unordered_set<std::string> messages;
+    for (int i = 0; i < count; ++i) {
+        messages.emplace(to_string_view(consumer->poll(30s).payload()));
+    }
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(messages.contains("Test message " + std::to_string(i)));
+    }
+    auto deadline = std::chrono::steady_clock::now() + 30s;
+    while (!publisher->spool()->empty() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_TRUE(publisher->spool()->empty());
+
+    messenger.destroy_publisher(ChannelId("pub1"));
+    publisher.reset();
+    std::filesystem::remove_all(spool_directory);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_PublisherSwitchesToCompressionChosenFromSampledMessages) {
+    KafkaMessenger messenger;
+
+    KafkaAdaptiveCompressionOptions compression_opts;
+    compression_opts.set_sample_interval(1);
+    compression_opts.set_sample_window(5);
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    publisher_opts.set_adaptive_compression(compression_opts);
+    auto publisher = messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    constexpr int count = 10;
+    std::string payload(16 * 1024, 'x');
+    for (int i = 0; i < count; ++i) {
+        publisher->publish(KafkaMessage(pack(payload + std::to_string(i))));
+    }
+
+    std::unordered_set<std::string> messages;
+    for (int i = 0; i < count; ++i) {
+        messages.emplace(to_string_view(consumer->poll(30s).payload()));
+    }
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(messages.contains(payload + std::to_string(i)));
+    }
+
+    KafkaCompressionStats stats = publisher->compression_stats();
+    EXPECT_TRUE(stats.selected());
+    EXPECT_EQ(stats.codec(), KafkaOptions::CompressionTypeEnum::GZIP);
+    EXPECT_EQ(stats.sampled_messages(), count);
+    ASSERT_TRUE(stats.ratio());
+    EXPECT_GT(*stats.ratio(), 10.0);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_MessagesArePolledIntoReusedMessage) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    auto publisher = messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    consumer_opts.set_record_pool_size(16);
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    constexpr int count = 10;
+    for (int i = 0; i < count; ++i) {
+        publisher->publish(KafkaMessage(pack("Test message " + std::to_string(i))));
+    }
+
+    KafkaMessage msg;
+    std::unordered_set<std::string> messages;
+    for (int i = 0; i < count; ++i) {
+        consumer->poll_into(msg, 30s);
+        ASSERT_TRUE(msg.delivery_metadata());
+        EXPECT_EQ(msg.delivery_metadata()->topic(), "topic1");
+        messages.emplace(to_string_view(msg.payload()));
+    }
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(messages.contains("Test message " + std::to_string(i)));
+    }
+    EXPECT_THROW(consumer->poll_into(msg, 100ms), EndOfStreamError);
+    EXPECT_TRUE(messages.contains(std::string(to_string_view(msg.payload()))));
+}
+
+TEST_F(KafkaMessengerTest, Messenger_ProtobufsAreSerializedStraightIntoProducerBuffers) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    auto publisher = messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    constexpr int count = 10;
+    for (int i = 0; i < count; ++i) {
+        BenchmarkMessage proto;
+        proto.set_id("Test message " + std::to_string(i));
+        publisher->publish(proto);
+    }
+
+    std::unordered_set<std::string> messages;
+    for (int i = 0; i < count; ++i) {
+        messages.emplace(unpack<BenchmarkMessage>(consumer->poll(30s).payload()).id());
+    }
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(messages.contains("Test message " + std::to_string(i)));
+    }
+}
+
+TEST_F(KafkaMessengerTest, Messenger_ConsumerIsStoppedFromSubscribedHandler) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    std::promise<void> stopped;
+    std::atomic_bool stop_called(false);
+    messenger.subscribe(ChannelId("cons1"), [&](const KafkaMessage& msg) {
+        if (stop_called.exchange(true)) { return; }
+        consumer->stop();
+        stopped.set_value();
+    });
+
+    messenger.get_publisher(ChannelId("pub1"))->publish(KafkaMessage(pack("Test message")));
+
+    EXPECT_EQ(stopped.get_future().wait_for(30s), std::future_status::ready);
+    EXPECT_TRUE(consumer->stopped());
+}
+
+TEST_F(KafkaMessengerTest, Messenger_ConsumerIsStoppedFromWorker) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    consumer_opts.set_worker_count(2);
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    std::promise<void> stopped;
+    std::atomic_bool stop_called(false);
+    consumer->start_workers([&](const KafkaMessage& msg) {
+        if (stop_called.exchange(true)) { return; }
+        consumer->stop();
+        stopped.set_value();
+    });
+
+    messenger.get_publisher(ChannelId("pub1"))->publish(KafkaMessage(pack("Test message")));
+
+    EXPECT_EQ(stopped.get_future().wait_for(30s), std::future_status::ready);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_ConsumerIsStoppedFromReadableCallback) {
+    KafkaMessenger messenger;
+
+    KafkaPublisherOptions publisher_opts;
+    publisher_opts.set_bootstrap_servers(_servers);
+    publisher_opts.set_topic_name("topic1");
+    messenger.create_publisher(ChannelId("pub1"), publisher_opts);
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    std::promise<void> stopped;
+    consumer->notify_when_readable([&] {
+        consumer->stop();
+        stopped.set_value();
+    });
+
+    messenger.get_publisher(ChannelId("pub1"))->publish(KafkaMessage(pack("Test message")));
+
+    EXPECT_EQ(stopped.get_future().wait_for(30s), std::future_status::ready);
+}
+
+TEST_F(KafkaMessengerTest, Messenger_BlockedPollIsInterruptedByStop) {
+    KafkaMessenger messenger;
+
+    KafkaConsumerOptions consumer_opts;
+    consumer_opts.set_bootstrap_servers(_servers);
+    consumer_opts.set_topic_name("topic1");
+    auto consumer = messenger.create_consumer(ChannelId("cons1"), consumer_opts);
+
+    auto poll_result = std::async(std::launch::async, [&] { consumer->poll(30s); });
+    std::this_thread::sleep_for(100ms);
+
+    auto started_at = std::chrono::steady_clock::now();
+    consumer->stop();
+    EXPECT_THROW(poll_result.get(), EndOfStreamError);
+    EXPECT_LT(std::chrono::steady_clock::now() - started_at, 5s);
+}
\ No newline at end of file
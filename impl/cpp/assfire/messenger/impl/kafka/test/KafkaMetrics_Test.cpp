@@ -0,0 +1,116 @@
+#include "assfire/messenger/impl/kafka/KafkaMetrics.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace assfire::messenger;
+
+namespace {
+    // Trimmed statistics of librdkafka consumer, see STATISTICS.md of librdkafka
+    constexpr const char* CONSUMER_STATISTICS = R"({
+        "name": "rdkafka#consumer-1", "type": "consumer", "ts": 5016483227792, "time": 1527060869,
+        "msg_cnt": 0, "msg_size": 0, "txmsgs": 0, "txmsg_bytes": 0, "rxmsgs": 120, "rxmsg_bytes": 4800,
+        "brokers": {
+            "localhost:9092/1": {
+                "name": "localhost:9092/1", "nodeid": 1, "outbuf_cnt": 2, "waitresp_cnt": 1,
+                "rtt": {"min": 100, "max": 9000, "avg": 1500, "p50": 1200, "p99": 8500, "cnt": 10}
+            }
+        },
+        "topics": {
+            "topic1": {
+                "topic": "topic1",
+                "batchsize": {"avg": 0, "p99": 0},
+                "batchcnt": {"avg": 0, "p99": 0},
+                "partitions": {
+                    "0": {"partition": 0, "msgq_cnt": 0, "xmit_msgq_cnt": 0, "fetchq_cnt": 7, "committed_offset": 40,
+                          "hi_offset": 50, "consumer_lag": 10},
+                    "1": {"partition": 1, "msgq_cnt": 0, "xmit_msgq_cnt": 0, "fetchq_cnt": 0, "committed_offset": -1001,
+                          "hi_offset": 20, "consumer_lag": -1},
+                    "-1": {"partition": -1, "msgq_cnt": 0, "xmit_msgq_cnt": 0, "fetchq_cnt": 0}
+                }
+            }
+        }
+    })";
+
+    constexpr const char* PRODUCER_STATISTICS = R"({
+        "name": "rdkafka#producer-1", "type": "producer", "time": 1527060869,
+        "msg_cnt": 3, "msg_size": 96, "txmsgs": 500, "txmsg_bytes": 16000,
+        "brokers": {},
+        "topics": {
+            "topic1": {
+                "topic": "topic1",
+                "batchsize": {"avg": 3200.5, "p99": 6400},
+                "batchcnt": {"avg": 100.25, "p99": 200},
+                "partitions": {
+                    "0": {"partition": 0, "msgq_cnt": 1, "xmit_msgq_cnt": 2, "fetchq_cnt": 0, "hi_offset": -1, "consumer_lag": -1}
+                }
+            }
+        }
+    })";
+} // namespace
+
+TEST(KafkaMetricsTest, ConsumerStatisticsAreParsed) {
+    KafkaMetrics metrics = parse_kafka_statistics(CONSUMER_STATISTICS);
+
+    EXPECT_EQ(metrics.client_name, "rdkafka#consumer-1");
+    EXPECT_EQ(metrics.collected_at, std::chrono::system_clock::time_point(std::chrono::seconds(1527060869)));
+    EXPECT_EQ(metrics.received_messages, 120);
+    EXPECT_EQ(metrics.received_bytes, 4800);
+
+    ASSERT_EQ(metrics.brokers.size(), 1);
+    EXPECT_EQ(metrics.brokers[0].name, "localhost:9092/1");
+    EXPECT_EQ(metrics.brokers[0].in_flight_requests, 1);
+    EXPECT_EQ(metrics.brokers[0].queued_requests, 2);
+    EXPECT_EQ(metrics.brokers[0].rtt_avg, std::chrono::microseconds(1500));
+    EXPECT_EQ(metrics.brokers[0].rtt_p50, std::chrono::microseconds(1200));
+    EXPECT_EQ(metrics.brokers[0].rtt_p99, std::chrono::microseconds(8500));
+
+    ASSERT_EQ(metrics.partitions.size(), 2);
+    EXPECT_EQ(metrics.partitions[0].partition, 0);
+    EXPECT_EQ(metrics.partitions[0].fetch_queue_messages, 7);
+    EXPECT_EQ(metrics.partitions[0].committed_offset, 40);
+    EXPECT_EQ(metrics.partitions[0].high_watermark, 50);
+    EXPECT_EQ(metrics.partitions[0].consumer_lag, 10);
+    EXPECT_EQ(metrics.partitions[1].consumer_lag, -1);
+    EXPECT_EQ(metrics.total_consumer_lag(), 10);
+}
+
+TEST(KafkaMetricsTest, ProducerStatisticsAreParsed) {
+    KafkaMetrics metrics = parse_kafka_statistics(PRODUCER_STATISTICS);
+
+    EXPECT_EQ(metrics.queued_messages, 3);
+    EXPECT_EQ(metrics.queued_bytes, 96);
+    EXPECT_EQ(metrics.sent_messages, 500);
+    EXPECT_EQ(metrics.sent_bytes, 16000);
+    EXPECT_TRUE(metrics.brokers.empty());
+
+    ASSERT_EQ(metrics.topics.size(), 1);
+    EXPECT_EQ(metrics.topics[0].topic, "topic1");
+    EXPECT_DOUBLE_EQ(metrics.topics[0].batch_size_avg, 3200.5);
+    EXPECT_EQ(metrics.topics[0].batch_size_p99, 6400);
+    EXPECT_DOUBLE_EQ(metrics.topics[0].batch_messages_avg, 100.25);
+    EXPECT_EQ(metrics.topics[0].batch_messages_p99, 200);
+
+    ASSERT_EQ(metrics.partitions.size(), 1);
+    EXPECT_EQ(metrics.partitions[0].queued_messages, 3);
+}
+
+TEST(KafkaMetricsTest, MalformedStatisticsAreRejected) {
+    EXPECT_THROW(parse_kafka_statistics("{\"name\": "), std::invalid_argument);
+    EXPECT_THROW(parse_kafka_statistics("[]"), std::invalid_argument);
+}
+
+TEST(KafkaMetricsTest, CollectorKeepsLastParsedStatistics) {
+    KafkaStatisticsCollector collector;
+    EXPECT_FALSE(collector.metrics());
+
+    collector.on_statistics(CONSUMER_STATISTICS);
+    ASSERT_TRUE(collector.metrics());
+    EXPECT_EQ(collector.metrics()->client_name, "rdkafka#consumer-1");
+
+    collector.on_statistics("not a json");
+    ASSERT_TRUE(collector.metrics());
+    EXPECT_EQ(collector.metrics()->client_name, "rdkafka#consumer-1");
+
+    collector.on_statistics(PRODUCER_STATISTICS);
+    EXPECT_EQ(collector.metrics()->client_name, "rdkafka#producer-1");
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "assfire/messenger/impl/kafka/KafkaOffsetTracker.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace assfire::messenger;
+
+TEST(KafkaOffsetTrackerTest, InOrderAcksAdvanceWatermark) {
+    KafkaOffsetTracker tracker;
+    tracker.on_delivered(0, 100);
+    tracker.on_delivered(0, 101);
+
+    EXPECT_EQ(tracker.ack(0, 100), 101);
+    EXPECT_EQ(tracker.ack(0, 101), 102);
+    EXPECT_EQ(tracker.in_flight(0), 0);
+}
+
+TEST(KafkaOffsetTrackerTest, OutOfOrderAcksWaitForContiguousPrefix) {
+    KafkaOffsetTracker tracker;
+    for (std::int64_t offset = 100; offset <= 105; ++offset) {
+        tracker.on_delivered(0, offset);
+    }
+
+    EXPECT_EQ(tracker.ack(0, 105), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 102), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 101), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 100), 103);
+    EXPECT_EQ(tracker.in_flight(0), 3);
+    EXPECT_EQ(tracker.ack(0, 104), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 103), 106);
+}
+
+TEST(KafkaOffsetTrackerTest, SkippedOffsetsAreTreatedAsAcked) {
+    KafkaOffsetTracker tracker;
+    tracker.on_delivered(0, 10);
+    tracker.on_delivered(0, 15);
+
+    EXPECT_EQ(tracker.ack(0, 10), 15);
+    EXPECT_EQ(tracker.ack(0, 15), 16);
+}
+
+TEST(KafkaOffsetTrackerTest, SkippedOffsetsAreNeitherInFlightNorAckable) {
+    KafkaOffsetTracker tracker;
+    for (std::int64_t i = 0; i < 100; ++i) {
+        tracker.on_delivered(0, i * 10);
+    }
+    EXPECT_EQ(tracker.in_flight(0), 100);
+
+    EXPECT_EQ(tracker.ack(0, 10), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 11), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 0), 20);
+    EXPECT_EQ(tracker.in_flight(0), 98);
+}
+
+TEST(KafkaOffsetTrackerTest, GapAfterAllOffsetsAreAckedTakesNoSlots) {
+    KafkaOffsetTracker tracker;
+    tracker.on_delivered(0, 0);
+    EXPECT_EQ(tracker.ack(0, 0), 1);
+
+    tracker.on_delivered(0, 1'000'000'000);
+    tracker.on_delivered(0, 1'000'000'001);
+    EXPECT_EQ(tracker.in_flight(0), 2);
+    EXPECT_EQ(tracker.ack(0, 1'000'000'001), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 1'000'000'000), 1'000'000'002);
+}
+
+TEST(KafkaOffsetTrackerTest, PartitionsAreTrackedIndependently) {
+    KafkaOffsetTracker tracker;
+    tracker.on_delivered(0, 0);
+    tracker.on_delivered(0, 1);
+    tracker.on_delivered(1, 0);
+
+    EXPECT_EQ(tracker.ack(0, 1), std::nullopt);
+    EXPECT_EQ(tracker.ack(1, 0), 1);
+    EXPECT_EQ(tracker.ack(0, 0), 2);
+}
+
+TEST(KafkaOffsetTrackerTest, UnknownAndDuplicateAcksAreIgnored) {
+    KafkaOffsetTracker tracker;
+    tracker.on_delivered(0, 5);
+
+    EXPECT_EQ(tracker.ack(1, 5), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 6), std::nullopt);
+    EXPECT_EQ(tracker.ack(0, 5), 6);
+    EXPECT_EQ(tracker.ack(0, 5), std::nullopt);
+
+    tracker.reset(0);
+    EXPECT_EQ(tracker.ack(0, 5), std::nullopt);
+}
+
+TEST(KafkaOffsetTrackerTest, RingGrowsBeyondInitialCapacity) {
+    KafkaOffsetTracker tracker;
+    for (std::int64_t offset = 0; offset < 1000; ++offset) {
+        tracker.on_delivered(0, offset);
+    }
+    EXPECT_EQ(tracker.in_flight(0), 1000);
+
+    for (std::int64_t offset = 999; offset > 0; --offset) {
+        EXPECT_EQ(tracker.ack(0, offset), std::nullopt);
+    }
+    EXPECT_EQ(tracker.ack(0, 0), 1000);
+}
\ No newline at end of file
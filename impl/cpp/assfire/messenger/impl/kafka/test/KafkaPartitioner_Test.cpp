@@ -0,0 +1,44 @@
+#include "assfire/messenger/impl/kafka/KafkaPartitioner.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace assfire::messenger;
+
+TEST(KafkaPartitionerTest, MessagesWithSameHeaderValueGoToSamePartition) {
+    HeaderHashPartitioner partitioner(HeaderId("tenant"));
+
+    Message msg1(pack("Test message 1"));
+    msg1.add_header(Header("tenant", "tenant-1"));
+    Message msg2(pack("Test message 2"));
+    msg2.add_header(Header("tenant", "tenant-1"));
+
+    auto partition = partitioner.partition(msg1, 12);
+    ASSERT_TRUE(partition);
+    EXPECT_GE(*partition, 0);
+    EXPECT_LT(*partition, 12);
+    EXPECT_EQ(partitioner.partition(msg2, 12), partition);
+}
+
+TEST(KafkaPartitionerTest, MessageWithoutHeaderIsLeftToDefaultPartitioning) {
+    HeaderHashPartitioner partitioner(HeaderId("tenant"));
+
+    EXPECT_FALSE(partitioner.partition(Message(pack("Test message 1")), 12));
+    EXPECT_FALSE(partitioner.partition(Message(pack("Test message 1")), 0));
+}
+
+TEST(KafkaPartitionerTest, AddingPartitionMovesOnlyShareOfKeys) {
+    constexpr int keys_count = 10000;
+
+    int moved = 0;
+    for (std::uint64_t key = 0; key < keys_count; ++key) {
+        std::int32_t before = jump_consistent_hash(key, 10);
+        std::int32_t after  = jump_consistent_hash(key, 11);
+        EXPECT_GE(before, 0);
+        EXPECT_LT(before, 10);
+        if (before != after) {
+            EXPECT_EQ(after, 10);
+            ++moved;
+        }
+    }
+    EXPECT_LT(moved, keys_count / 5);
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "assfire/messenger/impl/kafka/KafkaPendingCommits.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace assfire::messenger;
+
+using Offsets = std::map<std::int32_t, std::int64_t>;
+
+TEST(KafkaPendingCommitsTest, HighestAddedOffsetIsTakenOnce) {
+    KafkaPendingCommits commits;
+    commits.add(0, 10);
+    commits.add(0, 5);
+    commits.add(1, 3);
+
+    EXPECT_EQ(commits.take(), (Offsets {{0, 10}, {1, 3}}));
+    EXPECT_TRUE(commits.empty());
+    EXPECT_EQ(commits.take(), Offsets());
+}
+
+TEST(KafkaPendingCommitsTest, FailedCommitIsRetried) {
+    KafkaPendingCommits commits;
+    commits.add(0, 10);
+    commits.take();
+    commits.on_failed(0, 10);
+
+    EXPECT_EQ(commits.take(), (Offsets {{0, 10}}));
+}
+
+TEST(KafkaPendingCommitsTest, OlderCommitFailingAfterNewerSucceededIsNotRetried) {
+    KafkaPendingCommits commits;
+    commits.add(0, 10);
+    commits.take();
+    commits.add(0, 20);
+    commits.take();
+
+    commits.on_committed(0, 20);
+    commits.on_failed(0, 10);
+    EXPECT_TRUE(commits.empty());
+
+    commits.add(0, 15);
+    EXPECT_EQ(commits.take(), Offsets());
+}
+
+TEST(KafkaPendingCommitsTest, OlderCommitFailingWhileNewerIsInFlightIsNotRetried) {
+    KafkaPendingCommits commits;
+    commits.add(0, 10);
+    commits.take();
+    commits.add(0, 20);
+    commits.take();
+
+    commits.on_failed(0, 10);
+    EXPECT_TRUE(commits.empty());
+    commits.on_failed(0, 20);
+    EXPECT_EQ(commits.take(), (Offsets {{0, 20}}));
+}
+
+TEST(KafkaPendingCommitsTest, ResetPartitionIsNotRetried) {
+    KafkaPendingCommits commits;
+    commits.add(0, 10);
+    commits.take();
+    commits.reset(0);
+    commits.on_failed(0, 10);
+
+    EXPECT_TRUE(commits.empty());
+}
\ No newline at end of file
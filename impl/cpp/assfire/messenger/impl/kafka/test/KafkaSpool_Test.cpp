@@ -0,0 +1,191 @@
+#include "assfire/logger/impl/spdlog/SpdlogLoggerFactory.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+#include "assfire/messenger/impl/kafka/KafkaSpool.hpp"
+
+#include <condition_variable>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+using SpooledMessage = assfire::messenger::Message;
+
+namespace {
+    // Collects replayed payloads, failing first replay attempts if asked to
+    class Replayer {
+      public:
+        explicit Replayer(int failures = 0) : _failures(failures) {}
+
+        bool replay(std::span<const SpooledMessage> messages) {
+            std::lock_guard<std::mutex> lck(_mtx);
+            ++_calls;
+            if (_failures > 0) {
+                --_failures;
+                return false;
+            }
+            for (const auto& msg : messages) {
+                _payloads.emplace_back(to_string_view(msg.payload()));
+            }
+            _cv.notify_all();
+            return true;
+        }
+
+        std::vector<std::string> wait_for(std::size_t count) {
+            std::unique_lock<std::mutex> lck(_mtx);
+            _cv.wait_for(lck, 30s, [&] { return _payloads.size() >= count; });
+            return _payloads;
+        }
+
+        int calls() {
+            std::lock_guard<std::mutex> lck(_mtx);
+            return _calls;
+        }
+
+      private:
+        int _failures;
+        int _calls = 0;
+        std::vector<std::string> _payloads;
+        std::mutex _mtx;
+        std::condition_variable _cv;
+    };
+
+    std::vector<std::string> expected_payloads(int count) {
+        std::vector<std::string> result;
+        for (int i = 0; i < count; ++i) {
+            result.push_back("Test message " + std::to_string(i));
+        }
+        return result;
+    }
+} // namespace
+
+class KafkaSpoolTest : public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        assfire::logger::SpdlogLoggerFactory::register_static_factory();
+    }
+
+    void SetUp() override {
+        options.set_directory((std::filesystem::temp_directory_path() / ("assfire_kafka_spool_test." + std::to_string(getpid()))).string());
+        options.set_segment_size(4096);
+        options.set_replay_batch_size(4);
+        options.set_replay_rate(0);
+        options.set_retry_backoff(10ms);
+        std::filesystem::remove_all(options.directory());
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(options.directory());
+    }
+
+    KafkaSpoolOptions options;
+};
+
+TEST_F(KafkaSpoolTest, EncodedMessageIsDecodedWithKeyAndHeaders) {
+    SpooledMessage msg(pack("Test message"));
+    msg.set_key("key1");
+    msg.add_header(Header("header1", "value1"));
+    msg.add_header(Header("header2", ""));
+
+    SpooledMessage decoded = KafkaSpool::decode(KafkaSpool::encode(msg));
+    EXPECT_EQ(to_string_view(decoded.payload()), "Test message");
+    EXPECT_EQ(decoded.key(), "key1");
+    EXPECT_EQ(decoded.header("header1"), "value1");
+    EXPECT_EQ(decoded.header("header2"), "");
+
+    SpooledMessage decoded_without_key = KafkaSpool::decode(KafkaSpool::encode(SpooledMessage(pack("Test message"))));
+    EXPECT_FALSE(decoded_without_key.key());
+    EXPECT_TRUE(decoded_without_key.headers().empty());
+
+    std::vector<std::uint8_t> truncated = KafkaSpool::encode(msg);
+    truncated.resize(10);
+    EXPECT_THROW(KafkaSpool::decode(truncated), std::invalid_argument);
+}
+
+TEST_F(KafkaSpoolTest, SpooledMessagesAreReplayedInOrder) {
+    Replayer replayer;
+    KafkaSpool spool(options, [&](std::span<const SpooledMessage> messages) { return replayer.replay(messages); });
+
+    for (int i = 0; i < 10; ++i) {
+        spool.append(SpooledMessage(pack("Test message " + std::to_string(i))));
+    }
+
+    EXPECT_EQ(replayer.wait_for(10), expected_payloads(10));
+    EXPECT_EQ(spool.spooled_messages(), 10);
+}
+
+TEST_F(KafkaSpoolTest, AsynchronouslyAppendedMessagesAreReplayedInOrder) {
+    Replayer replayer;
+    KafkaSpool spool(options, [&](std::span<const SpooledMessage> messages) { return replayer.replay(messages); });
+
+    for (int i = 0; i < 10; ++i) {
+        spool.append_async(SpooledMessage(pack("Test message " + std::to_string(i))));
+    }
+
+    EXPECT_EQ(replayer.wait_for(10), expected_payloads(10));
+    EXPECT_EQ(spool.spooled_messages(), 10);
+}
+
+TEST_F(KafkaSpoolTest, SpoolIsNotEmptyUntilAsynchronouslyAppendedMessagesAreReplayed) {
+    Replayer replayer;
+    KafkaSpool spool(options, [&](std::span<const SpooledMessage> messages) { return replayer.replay(messages); });
+    EXPECT_TRUE(spool.empty());
+
+    spool.append_async(SpooledMessage(pack("Test message 0")));
+    EXPECT_FALSE(spool.empty());
+
+    EXPECT_EQ(replayer.wait_for(1), expected_payloads(1));
+    auto deadline = std::chrono::steady_clock::now() + 30s;
+    while (!spool.empty() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_TRUE(spool.empty());
+}
+
+TEST_F(KafkaSpoolTest, UndeliveredBatchIsReplayedAgain) {
+    Replayer replayer(2);
+    KafkaSpool spool(options, [&](std::span<const SpooledMessage> messages) { return replayer.replay(messages); });
+
+    for (int i = 0; i < 10; ++i) {
+        spool.append(SpooledMessage(pack("Test message " + std::to_string(i))));
+    }
+
+    EXPECT_EQ(replayer.wait_for(10), expected_payloads(10));
+    EXPECT_GE(replayer.calls(), 5);
+}
+
+TEST_F(KafkaSpoolTest, MessagesLeftByStoppedSpoolAreReplayedByNextOne) {
+    {
+        KafkaSpool spool(options, [](std::span<const SpooledMessage>) { return false; });
+        for (int i = 0; i < 10; ++i) {
+            spool.append(SpooledMessage(pack("Test message " + std::to_string(i))));
+        }
+        spool.stop();
+        EXPECT_FALSE(spool.empty());
+    }
+
+    Replayer replayer;
+    KafkaSpool spool(options, [&](std::span<const SpooledMessage> messages) { return replayer.replay(messages); });
+    EXPECT_EQ(replayer.wait_for(10), expected_payloads(10));
+}
+
+TEST_F(KafkaSpoolTest, ReplayIsRateLimited) {
+    options.set_replay_rate(100);
+    Replayer replayer;
+    KafkaSpool spool(options, [&](std::span<const SpooledMessage> messages) { return replayer.replay(messages); });
+
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20; ++i) {
+        spool.append(SpooledMessage(pack("Test message " + std::to_string(i))));
+    }
+    EXPECT_EQ(replayer.wait_for(20), expected_payloads(20));
+    EXPECT_GE(std::chrono::steady_clock::now() - started, 150ms);
+}
+
+TEST_F(KafkaSpoolTest, MessageNotFittingIntoSegmentIsRejected) {
+    KafkaSpool spool(options, [](std::span<const SpooledMessage>) { return true; });
+    EXPECT_THROW(spool.append(SpooledMessage(pack(std::string(options.segment_size(), 'x')))), PublisherError);
+}
\ No newline at end of file
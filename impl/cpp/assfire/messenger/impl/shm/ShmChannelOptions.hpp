@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace assfire::messenger {
+    // All processes sharing a channel must use the same slot count and slot size
+    class ShmChannelOptions {
+      public:
+        ShmChannelOptions()                             = default;
+        ShmChannelOptions(const ShmChannelOptions &rhs) = default;
+        ShmChannelOptions(ShmChannelOptions &&rhs)      = default;
+
+        ShmChannelOptions &operator=(const ShmChannelOptions &rhs) = default;
+        ShmChannelOptions &operator=(ShmChannelOptions &&rhs) = default;
+
+        bool operator==(const ShmChannelOptions &rhs) const = default;
+
+        std::string to_string() const {
+            return "{slot_count = " + std::to_string(_slot_count) + ",slot_size = " + std::to_string(_slot_size) +
+                   (_segment_name ? ",segment_name = " + *_segment_name : "") + ",publish_timeout_ms = " + std::to_string(_publish_timeout.count()) +
+                   "}";
+        }
+
+        // Number of messages which may be published but not yet polled or still referenced by consumers, rounded up to a power of two
+        std::uint64_t slot_count() const {
+            return _slot_count;
+        }
+        void set_slot_count(std::uint64_t slot_count) {
+            _slot_count = slot_count;
+        }
+
+        // Maximum size of encoded message: payload, key and headers together with 12 bytes of sizes plus 8 bytes per header
+        std::uint32_t slot_size() const {
+            return _slot_size;
+        }
+        void set_slot_size(std::uint32_t slot_size) {
+            _slot_size = slot_size;
+        }
+
+        // Name of shared memory segment, derived from channel name when unset
+        const std::optional<std::string> &segment_name() const {
+            return _segment_name;
+        }
+        void set_segment_name(std::optional<std::string> segment_name) {
+            _segment_name = std::move(segment_name);
+        }
+
+        // How long publish waits for a free slot before failing
+        std::chrono::milliseconds publish_timeout() const {
+            return _publish_timeout;
+        }
+        void set_publish_timeout(std::chrono::milliseconds publish_timeout) {
+            _publish_timeout = publish_timeout;
+        }
+
+      private:
+        std::uint64_t _slot_count = 1024;
+        std::uint32_t _slot_size  = 4096;
+        std::optional<std::string> _segment_name;
+        std::chrono::milliseconds _publish_timeout = std::chrono::seconds(10);
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "ShmConsumer.hpp"
+
+#include "ShmRecord.hpp"
+#include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+#include "assfire/messenger/impl/util/ScopedThreadRole.hpp"
+
+#include <algorithm>
+
+namespace assfire::messenger {
+
+    namespace {
+        // Handler task yields arena thread to other channels after handling this many messages
+        constexpr std::size_t HANDLER_TASK_BATCH = 64;
+        // Watcher and drain recheck the ring at least this often, so they don't depend on wakeups of writers of other processes alone
+        constexpr std::chrono::milliseconds WATCH_TIMEOUT = std::chrono::milliseconds(100);
+        // Handler calling stop() must not wait for its own task
+        constexpr int HANDLER_ROLE = 1;
+    } // namespace
+
+    ShmConsumer::ShmConsumer(ChannelId channel_id, std::shared_ptr<ShmRing> ring, std::shared_ptr<tbb::task_arena> handlers_arena)
+        : _topic(std::make_shared<const std::string>(channel_id.name())),
+          _ring(std::move(ring)),
+          _interrupted(false),
+          _paused(false),
+          _handlers_arena(std::move(handlers_arena)),
+          _subscribed(false),
+          _running_handlers(0),
+          _logger(logger::LoggerProvider::get("assfire.messenger.ShmConsumer")) {}
+
+    ShmConsumer::~ShmConsumer() {
+        stop();
+        // Readable callback destroying the consumer runs on the watcher, which can't join itself
+        if (_watcher.joinable()) { _watcher.detach(); }
+    }
+
+    Message ShmConsumer::poll() {
+        while (true) {
+            try {
+                return poll(std::chrono::minutes(1));
+            } catch (const TimeoutError& e) {
+                // Just waiting for next loop
+            }
+        }
+    }
+
+    Message ShmConsumer::poll(std::chrono::milliseconds timeout) {
+        wait_for_new_messages(timeout);
+
+        Message msg;
+        if (!try_pop(msg)) { throw EndOfStreamError(); }
+        return msg;
+    }
+
+    std::size_t ShmConsumer::poll_batch(std::vector<Message>& messages, std::size_t max_messages, std::chrono::milliseconds timeout) {
+        if (max_messages == 0) { return 0; }
+        wait_for_new_messages(timeout);
+
+        std::size_t polled = try_poll_batch(messages, max_messages);
+        if (polled == 0) { throw EndOfStreamError(); }
+        return polled;
+    }
+
+    std::size_t ShmConsumer::try_poll_batch(std::vector<Message>& messages, std::size_t max_messages) {
+        std::size_t polled = 0;
+        Message msg;
+        while (polled < max_messages && try_pop(msg)) {
+            messages.push_back(std::move(msg));
+            ++polled;
+        }
+        return polled;
+    }
+
+    // Watcher and stop take callbacks under the same lock after noticing messages or interrupting, so callback is either
+    // invoked here because messages are already there or consumer is stopped, or taken by the watcher or stop
+    std::uint64_t ShmConsumer::notify_when_readable(std::function<void()> callback) {
+        start_watch_loop();
+        std::uint64_t id;
+        {
+            std::lock_guard<std::mutex> lck(_readable_mtx);
+            id = ++_next_readable_callback_id;
+            if (!is_readable() && !_interrupted) {
+                _readable_callbacks.emplace(id, std::move(callback));
+                return id;
+            }
+        }
+        callback();
+        return id;
+    }
+
+    bool ShmConsumer::cancel_readable_notification(std::uint64_t id) {
+        std::lock_guard<std::mutex> lck(_readable_mtx);
+        return _readable_callbacks.erase(id) > 0;
+    }
+
+    bool ShmConsumer::stopped() const {
+        return _interrupted;
+    }
+
+    void ShmConsumer::ack(const Message& msg) {
+        const std::optional<DeliveryMetadata>& metadata = msg.delivery_metadata();
+        if (!metadata || metadata->topic() != *_topic) {
+            _logger->error("Failed to ack message with headers {}: message wasn't received from channel {}", msg.headers_to_string(), *_topic);
+            throw AckFailedError("Failed to ack message which wasn't received from channel " + *_topic);
+        }
+    }
+
+    void ShmConsumer::pause() {
+        _paused = true;
+    }
+
+    void ShmConsumer::resume() {
+        _paused = false;
+        _ring->readable_notifier().notify_all();
+    }
+
+    // Wakes pollers, watcher and readable callbacks and waits for running handlers. Messages left in channel stay there for other consumers.
+    // Called from a readable callback or a handler, it doesn't wait for the calling watcher or handler task
+    void ShmConsumer::stop() {
+        _interrupted = true;
+        _ring->readable_notifier().notify_all();
+        _ring->writable_notifier().notify_all();
+        if (_watcher.joinable() && _watcher.get_id() != std::this_thread::get_id()) { _watcher.join(); }
+        notify_readable();
+
+        std::size_t own_tasks = ScopedThreadRole::current(this, HANDLER_ROLE) ? 1 : 0;
+        std::unique_lock<std::mutex> lck(_handlers_mtx);
+        _handlers_cv.wait(lck, [&] { return _handler_tasks == own_tasks; });
+    }
+
+    void ShmConsumer::drain() {
+        while (!_ring->writable_notifier().wait_for([&] { return _ring->empty() || _interrupted; }, WATCH_TIMEOUT)) {}
+    }
+
+    void ShmConsumer::subscribe(MessageHandler handler, std::size_t concurrency) {
+        if (_subscribed) {
+            _logger->error("Failed to subscribe handler to channel {}: consumer is already subscribed", *_topic);
+            throw ConsumerError("Handler is already subscribed to channel " + *_topic);
+        }
+
+        if (!_handlers_arena) { _handlers_arena = std::make_shared<tbb::task_arena>(); }
+        _handler             = std::move(handler);
+        _handler_concurrency = std::max<std::size_t>(concurrency, 1);
+        _subscribed.store(true, std::memory_order_release);
+        start_watch_loop();
+    }
+
+    bool ShmConsumer::try_pop(Message& msg) {
+        if (_paused) { return false; }
+
+        std::uint64_t position     = 0;
+        std::uint32_t record_size  = 0;
+        const std::uint8_t* record = nullptr;
+        while (true) {
+            record = _ring->try_claim_read(position, record_size);
+            if (!record) { return false; }
+            // Segment is writable by any process mapping it, so slot contents aren't trusted
+            if (record_size <= _ring->slot_size() && ShmRecord::is_valid(record, record_size)) { break; }
+            _logger->error("Dropping corrupted record of {} bytes at position {} of channel {}", record_size, position, *_topic);
+            _ring->release_read(position);
+        }
+
+        auto holder = std::make_shared<const ShmRecord>(_ring, position, record, record_size);
+        msg         = Message(PayloadBuffer(holder, holder->payload_data(), holder->payload_size()));
+        msg.set_record_headers(holder);
+        if (holder->key()) { msg.set_key(std::string(*holder->key())); }
+        msg.set_delivery_metadata(DeliveryMetadata(_topic, 0, static_cast<std::int64_t>(position)));
+        return true;
+    }
+
+    bool ShmConsumer::is_readable() const {
+        return !_paused && !_ring->empty();
+    }
+
+    void ShmConsumer::wait_for_new_messages(std::chrono::milliseconds timeout) {
+        if (!_ring->readable_notifier().wait_for([&] { return is_readable() || _interrupted; }, timeout)) { throw TimeoutError(); }
+    }
+
+    void ShmConsumer::start_watch_loop() {
+        std::call_once(_watch_started, [this] { _watcher = std::thread(&ShmConsumer::watch_loop, this); });
+    }
+
+    void ShmConsumer::watch_loop() {
+        WakeupNotifier& notifier = _ring->readable_notifier();
+        while (!_interrupted) {
+            std::uint32_t epoch = notifier.epoch();
+            if (is_readable()) {
+                notify_readable();
+                if (_subscribed.load(std::memory_order_acquire)) { schedule_handlers(); }
+            }
+            notifier.wait_for([&] { return notifier.epoch() != epoch || _interrupted; }, WATCH_TIMEOUT);
+        }
+    }
+
+    void ShmConsumer::notify_readable() {
+        std::map<std::uint64_t, std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lck(_readable_mtx);
+            if (_readable_callbacks.empty()) { return; }
+            callbacks.swap(_readable_callbacks);
+        }
+        for (auto& [id, callback] : callbacks) {
+            callback();
+        }
+    }
+
+    void ShmConsumer::schedule_handlers() {
+        while (!_interrupted && is_readable()) {
+            std::size_t running = _running_handlers.load();
+            if (running >= _handler_concurrency) { return; }
+            if (_running_handlers.compare_exchange_weak(running, running + 1)) {
+                {
+                    // Rechecked under lock so that stop() either waits for this task or prevents it from being enqueued
+                    std::lock_guard<std::mutex> lck(_handlers_mtx);
+                    if (_interrupted) {
+                        _running_handlers.fetch_sub(1);
+                        return;
+                    }
+                    ++_handler_tasks;
+                }
+                _handlers_arena->enqueue([this] { run_handlers(); });
+            }
+        }
+    }
+
+    void ShmConsumer::run_handlers() {
+        ScopedThreadRole role(this, HANDLER_ROLE);
+        Message msg;
+        for (std::size_t handled = 0; handled < HANDLER_TASK_BATCH && !_interrupted && try_pop(msg); ++handled) {
+            handle_message(msg);
+        }
+        // Handled message releases its slot only once no copy refers to it
+        msg = Message();
+
+        // Messages that arrive after slot is released are seen either by this recheck or by the watcher
+        _running_handlers.fetch_sub(1);
+        schedule_handlers();
+
+        std::lock_guard<std::mutex> lck(_handlers_mtx);
+        --_handler_tasks;
+        _handlers_cv.notify_all();
+    }
+
+    void ShmConsumer::handle_message(const Message& msg) {
+        try {
+            _handler(msg);
+        } catch (const std::exception& e) {
+            _logger->error("Failed to handle message {}: {}", msg.delivery_metadata()->to_string(), e.what());
+        }
+        ack(msg);
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ShmRing.hpp"
+#include "assfire/logger/api/Logger.hpp"
+#include "assfire/messenger/api/ChannelId.hpp"
+#include "assfire/messenger/api/Consumer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <oneapi/tbb/task_arena.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace assfire::messenger {
+    // Consumer of a shared memory channel. Consumers of all processes attached to the channel compete for its messages.
+    // Polled messages refer to payload and headers right in the shared segment and hold their slot until the last copy
+    // of the message is gone, so a message kept for long blocks publishers once the ring wraps around to its slot.
+    // Delivery metadata has channel name as topic, partition 0 and position in channel as offset. Ack only validates the message
+    class ShmConsumer : public Consumer {
+      public:
+        ShmConsumer(ChannelId channel_id, std::shared_ptr<ShmRing> ring, std::shared_ptr<tbb::task_arena> handlers_arena = nullptr);
+        ~ShmConsumer();
+
+        virtual Message poll() override;
+        virtual Message poll(std::chrono::milliseconds timeout) override;
+        virtual std::size_t poll_batch(std::vector<Message>& messages, std::size_t max_messages, std::chrono::milliseconds timeout) override;
+        virtual void ack(const Message& msg) override;
+        virtual void pause() override;
+        virtual void resume() override;
+        virtual void stop() override;
+        virtual void drain() override;
+        virtual void subscribe(MessageHandler handler, std::size_t concurrency) override;
+        virtual std::size_t try_poll_batch(std::vector<Message>& messages, std::size_t max_messages) override;
+        virtual std::uint64_t notify_when_readable(std::function<void()> callback) override;
+        virtual bool cancel_readable_notification(std::uint64_t id) override;
+        virtual bool stopped() const override;
+
+      private:
+        bool try_pop(Message& msg);
+        bool is_readable() const;
+        void wait_for_new_messages(std::chrono::milliseconds timeout);
+        void start_watch_loop();
+        void watch_loop();
+        void notify_readable();
+        void schedule_handlers();
+        void run_handlers();
+        void handle_message(const Message& msg);
+
+        std::shared_ptr<const std::string> _topic;
+        std::shared_ptr<ShmRing> _ring;
+        std::atomic_bool _interrupted;
+        std::atomic_bool _paused;
+        // Publishers may live in other processes, so readable callbacks and handlers are driven by a watcher thread
+        std::once_flag _watch_started;
+        std::thread _watcher;
+        std::mutex _readable_mtx;
+        std::map<std::uint64_t, std::function<void()>> _readable_callbacks;
+        std::uint64_t _next_readable_callback_id = 0;
+        std::shared_ptr<tbb::task_arena> _handlers_arena;
+        MessageHandler _handler;
+        std::size_t _handler_concurrency = 0;
+        std::atomic_bool _subscribed;
+        // Running handlers hold concurrency slots, handler tasks are counted until they stop touching the consumer
+        std::atomic<std::size_t> _running_handlers;
+        std::size_t _handler_tasks = 0;
+        std::mutex _handlers_mtx;
+        std::condition_variable _handlers_cv;
+        std::shared_ptr<logger::Logger> _logger;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
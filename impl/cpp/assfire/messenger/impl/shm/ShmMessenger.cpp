@@ -0,0 +1,77 @@
+#include "ShmMessenger.hpp"
+
+#include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+
+#include <exception>
+
+namespace assfire::messenger {
+
+    ShmMessenger::ShmMessenger()
+        : _handlers_arena(std::make_shared<tbb::task_arena>()),
+          _logger(logger::LoggerProvider::get("assfire.messenger.ShmMessenger")) {}
+
+    std::shared_ptr<Publisher> ShmMessenger::get_publisher(const ChannelId& channel_id) {
+        tbb::concurrent_hash_map<ChannelId, Channel>::const_accessor accessor;
+        if (!_channels.find(accessor, channel_id)) {
+            _logger->error("Publisher channel {} is not declared", channel_id.name());
+            throw ChannelNotDeclaredError(channel_id);
+        }
+        return accessor->second.publisher;
+    }
+
+    std::shared_ptr<Consumer> ShmMessenger::get_consumer(const ChannelId& channel_id) {
+        tbb::concurrent_hash_map<ChannelId, Channel>::const_accessor accessor;
+        if (!_channels.find(accessor, channel_id)) {
+            _logger->error("Consumer channel {} is not declared", channel_id.name());
+            throw ChannelNotDeclaredError(channel_id);
+        }
+        return accessor->second.consumer;
+    }
+
+    std::shared_ptr<ShmConsumer> ShmMessenger::create_channel(ChannelId channel_id, ShmChannelOptions options) {
+        _logger->info("Creating shared memory channel {} (options: {})", channel_id.name(), options.to_string());
+
+        tbb::concurrent_hash_map<ChannelId, Channel>::accessor write_accessor;
+        bool is_new = _channels.insert(write_accessor, channel_id);
+
+        if (is_new) {
+            std::shared_ptr<ShmRing> ring;
+            try {
+                ring = std::make_shared<ShmRing>(segment_name(channel_id, options), options.slot_count(), options.slot_size());
+            } catch (const std::runtime_error& e) {
+                _logger->error("Failed to attach to shared memory channel {}: {}", channel_id.name(), e.what());
+                _channels.erase(write_accessor);
+                std::throw_with_nested(ConsumerConstructionError("Failed to attach to shared memory channel " + channel_id.name()));
+            }
+            write_accessor->second = Channel {std::make_shared<ShmConsumer>(channel_id, ring, _handlers_arena),
+                                              std::make_shared<ShmPublisher>(channel_id, ring, std::move(options))};
+        } else {
+            if (write_accessor->second.publisher->options() != options) {
+                _logger->error("Trying to redeclare existing shared memory channel {} (options = {}) with different options {} - this is not allowed",
+                               channel_id.name(), write_accessor->second.publisher->options().to_string(), options.to_string());
+                throw ChannelRedeclarationAttemptError(channel_id);
+            } else {
+                _logger->info("Found existing shared memory channel {}. It will be reused", channel_id.name());
+            }
+        }
+        return write_accessor->second.consumer;
+    }
+
+    void ShmMessenger::destroy_channel(ChannelId channel_id) {
+        tbb::concurrent_hash_map<ChannelId, Channel>::accessor write_accessor;
+        if (!_channels.find(write_accessor, channel_id)) { return; }
+        write_accessor->second.consumer->stop();
+        write_accessor->second.publisher->close();
+        _channels.erase(write_accessor);
+    }
+
+    void ShmMessenger::unlink_channel(const ChannelId& channel_id, const ShmChannelOptions& options) {
+        ShmRing::unlink(segment_name(channel_id, options));
+    }
+
+    std::string ShmMessenger::segment_name(const ChannelId& channel_id, const ShmChannelOptions& options) {
+        return options.segment_name().value_or("assfire.messenger." + channel_id.name());
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
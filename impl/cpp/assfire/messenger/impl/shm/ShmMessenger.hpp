@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ShmChannelOptions.hpp"
+#include "ShmConsumer.hpp"
+#include "ShmPublisher.hpp"
+#include "assfire/logger/api/Logger.hpp"
+#include "assfire/messenger/api/Messenger.hpp"
+
+#include <memory>
+#include <oneapi/tbb/concurrent_hash_map.h>
+#include <oneapi/tbb/task_arena.h>
+
+namespace assfire::messenger {
+    // Messenger for processes living on the same host. Channel is a ring buffer in a named shared memory segment,
+    // so every process that creates the channel with the same segment name and layout publishes to and consumes from the same ring.
+    // Segment outlives processes using it and is removed only by unlink_channel
+    class ShmMessenger : public Messenger {
+      public:
+        ShmMessenger();
+
+        virtual std::shared_ptr<Publisher> get_publisher(const ChannelId& channel_id) override;
+        virtual std::shared_ptr<Consumer> get_consumer(const ChannelId& channel_id) override;
+
+        // Attaches to channel's segment, creating it if no process has done it yet
+        std::shared_ptr<ShmConsumer> create_channel(ChannelId channel_id, ShmChannelOptions options = ShmChannelOptions());
+
+        // Stops local consumer and closes local publisher of the channel. Segment and messages in it are left for other processes
+        void destroy_channel(ChannelId channel_id);
+
+        // Removes channel's segment name, so the next create_channel starts with an empty ring
+        static void unlink_channel(const ChannelId& channel_id, const ShmChannelOptions& options = ShmChannelOptions());
+
+        static std::string segment_name(const ChannelId& channel_id, const ShmChannelOptions& options);
+
+      private:
+        struct Channel {
+            std::shared_ptr<ShmConsumer> consumer;
+            std::shared_ptr<ShmPublisher> publisher;
+        };
+
+        // Subscription handlers of all channels share this arena, so idle channels don't occupy threads
+        std::shared_ptr<tbb::task_arena> _handlers_arena;
+        tbb::concurrent_hash_map<ChannelId, Channel> _channels;
+        std::shared_ptr<logger::Logger> _logger;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "ShmPublisher.hpp"
+
+#include "ShmRecord.hpp"
+#include "assfire/logger/api/LoggerProvider.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+
+namespace assfire::messenger {
+
+    ShmPublisher::ShmPublisher(ChannelId channel_id, std::shared_ptr<ShmRing> ring, ShmChannelOptions options)
+        : _channel_name(channel_id.name()),
+          _ring(std::move(ring)),
+          _options(std::move(options)),
+          _closed(false),
+          _logger(logger::LoggerProvider::get("assfire.messenger.ShmPublisher")) {}
+
+    void ShmPublisher::publish(const Message& msg) {
+        push(msg);
+    }
+
+    void ShmPublisher::publish(const Message& msg, DeliveryCallback callback) {
+        std::uint64_t position = 0;
+        try {
+            position = push(msg);
+        } catch (const PublisherError& e) {
+            callback(DeliveryReport(e.what()));
+            return;
+        }
+        callback(DeliveryReport(0, static_cast<std::int64_t>(position)));
+    }
+
+    PublishBatchResult ShmPublisher::publish_batch(std::span<const Message> messages) {
+        std::vector<PublishFailure> failures;
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            try {
+                push(messages[i]);
+            } catch (const PublisherError& e) { failures.emplace_back(i, e.what()); }
+        }
+        return PublishBatchResult(messages.size(), std::move(failures));
+    }
+
+    void ShmPublisher::close() {
+        _closed = true;
+        _ring->writable_notifier().notify_all();
+    }
+
+    std::uint64_t ShmPublisher::push(const Message& msg) {
+        std::size_t size = ShmRecord::encoded_size(msg);
+        if (size > _ring->slot_size()) {
+            _logger->error("Failed to publish message to channel {}: encoded message of {} bytes exceeds slot size {}", _channel_name, size,
+                           _ring->slot_size());
+            throw PublisherError("Message doesn't fit into slot of channel " + _channel_name);
+        }
+
+        auto deadline          = std::chrono::steady_clock::now() + _options.publish_timeout();
+        std::uint64_t position = 0;
+        std::uint8_t* slot     = nullptr;
+        while (!(slot = _ring->try_claim_write(position))) {
+            auto now = std::chrono::steady_clock::now();
+            if (_closed || now >= deadline) {
+                _logger->error("Failed to publish message to channel {}: {}", _channel_name, _closed ? "publisher is closed" : "channel is full");
+                throw PublisherError(std::string(_closed ? "Publisher is closed" : "Timeout on waiting for free slot") + " of channel " +
+                                     _channel_name);
+            }
+            _ring->writable_notifier().wait_for([&] { return !_ring->full() || _closed; },
+                                                std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now));
+        }
+
+        ShmRecord::encode(msg, slot);
+        _ring->commit_write(position, static_cast<std::uint32_t>(size));
+        return position;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
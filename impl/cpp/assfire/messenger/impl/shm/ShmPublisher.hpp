@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ShmChannelOptions.hpp"
+#include "ShmRing.hpp"
+#include "assfire/logger/api/Logger.hpp"
+#include "assfire/messenger/api/ChannelId.hpp"
+#include "assfire/messenger/api/Publisher.hpp"
+
+#include <atomic>
+#include <memory>
+
+namespace assfire::messenger {
+    // Publisher to a shared memory channel. Message is encoded straight into a claimed slot and is delivered once the slot is committed,
+    // so delivery callbacks are invoked synchronously by publish. Publish waits for a free slot for at most publish timeout
+    class ShmPublisher : public Publisher {
+      public:
+        ShmPublisher(ChannelId channel_id, std::shared_ptr<ShmRing> ring, ShmChannelOptions options);
+
+        using Publisher::publish;
+        virtual void publish(const Message& msg) override;
+        virtual void publish(const Message& msg, DeliveryCallback callback) override;
+        virtual PublishBatchResult publish_batch(std::span<const Message> messages) override;
+
+        // Makes current and further publishing fail
+        void close();
+
+        const ShmChannelOptions& options() const {
+            return _options;
+        }
+
+      private:
+        std::uint64_t push(const Message& msg);
+
+        std::string _channel_name;
+        std::shared_ptr<ShmRing> _ring;
+        ShmChannelOptions _options;
+        std::atomic_bool _closed;
+        std::shared_ptr<logger::Logger> _logger;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
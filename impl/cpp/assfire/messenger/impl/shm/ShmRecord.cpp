@@ -0,0 +1,130 @@
+#include "ShmRecord.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace assfire::messenger {
+
+    namespace {
+        constexpr std::uint32_t NO_KEY = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t read_u32(const std::uint8_t*& in) {
+            std::uint32_t value;
+            std::memcpy(&value, in, sizeof(value));
+            in += sizeof(value);
+            return value;
+        }
+
+        void write_u32(std::uint8_t*& out, std::size_t value) {
+            auto narrowed = static_cast<std::uint32_t>(value);
+            std::memcpy(out, &narrowed, sizeof(narrowed));
+            out += sizeof(narrowed);
+        }
+
+        void write_bytes(std::uint8_t*& out, const void* data, std::size_t size) {
+            if (size > 0) { std::memcpy(out, data, size); }
+            out += size;
+        }
+    } // namespace
+
+    template <typename Visitor>
+    void ShmRecord::for_each_header(Visitor visit) const {
+        const std::uint8_t* in = _headers_data;
+        for (std::uint32_t i = 0; i < _headers_count; ++i) {
+            std::uint32_t name_size  = read_u32(in);
+            std::uint32_t value_size = read_u32(in);
+            std::string_view name(reinterpret_cast<const char*>(in), name_size);
+            std::string_view value(reinterpret_cast<const char*>(in + name_size), value_size);
+            in += name_size + value_size;
+            visit(name, value);
+        }
+    }
+
+    ShmRecord::ShmRecord(std::shared_ptr<ShmRing> ring, std::uint64_t position, const std::uint8_t* data, std::uint32_t size)
+        : _ring(std::move(ring)),
+          _position(position) {
+        const std::uint8_t* in = data;
+        _payload_size          = read_u32(in);
+        std::uint32_t key_size = read_u32(in);
+        _headers_count         = read_u32(in);
+        if (key_size != NO_KEY) {
+            _key = std::string_view(reinterpret_cast<const char*>(in), key_size);
+            in += key_size;
+        }
+        _headers_data = in;
+        // Payload is encoded last
+        _payload_data = data + size - _payload_size;
+    }
+
+    bool ShmRecord::is_valid(const std::uint8_t* data, std::uint32_t size) {
+        const std::uint8_t* in = data;
+        std::uint64_t left     = size;
+        auto take              = [&](std::uint64_t count) {
+            if (count > left) { return false; }
+            in += count;
+            left -= count;
+            return true;
+        };
+        auto take_u32 = [&](std::uint32_t& value) {
+            if (left < sizeof(value)) { return false; }
+            value = read_u32(in);
+            left -= sizeof(value);
+            return true;
+        };
+
+        std::uint32_t payload_size  = 0;
+        std::uint32_t key_size      = 0;
+        std::uint32_t headers_count = 0;
+        if (!take_u32(payload_size) || !take_u32(key_size) || !take_u32(headers_count)) { return false; }
+        if (key_size != NO_KEY && !take(key_size)) { return false; }
+        for (std::uint32_t i = 0; i < headers_count; ++i) {
+            std::uint32_t name_size  = 0;
+            std::uint32_t value_size = 0;
+            if (!take_u32(name_size) || !take_u32(value_size) || !take(std::uint64_t(name_size) + value_size)) { return false; }
+        }
+        return left == payload_size;
+    }
+
+    ShmRecord::~ShmRecord() {
+        _ring->release_read(_position);
+    }
+
+    std::size_t ShmRecord::encoded_size(const Message& msg) {
+        std::size_t size = 3 * sizeof(std::uint32_t) + (msg.key() ? msg.key()->size() : 0) + msg.payload().size();
+        for (const Header& h : msg.headers()) {
+            size += 2 * sizeof(std::uint32_t) + h.id().name().size() + h.value().size();
+        }
+        return size;
+    }
+
+    void ShmRecord::encode(const Message& msg, std::uint8_t* out) {
+        write_u32(out, msg.payload().size());
+        write_u32(out, msg.key() ? msg.key()->size() : NO_KEY);
+        write_u32(out, msg.headers().size());
+        if (msg.key()) { write_bytes(out, msg.key()->data(), msg.key()->size()); }
+        for (const Header& h : msg.headers()) {
+            write_u32(out, h.id().name().size());
+            write_u32(out, h.value().size());
+            write_bytes(out, h.id().name().data(), h.id().name().size());
+            write_bytes(out, h.value().data(), h.value().size());
+        }
+        write_bytes(out, msg.payload().data(), msg.payload().size());
+    }
+
+    std::optional<std::string_view> ShmRecord::find(std::string_view id) const {
+        // Like kafka record headers, the last header with given name wins
+        std::optional<std::string_view> result;
+        for_each_header([&](std::string_view name, std::string_view value) {
+            if (name == id) { result = value; }
+        });
+        return result;
+    }
+
+    std::vector<Header> ShmRecord::to_headers() const {
+        std::vector<Header> result;
+        result.reserve(_headers_count);
+        for_each_header([&](std::string_view name, std::string_view value) { result.emplace_back(name, Header::Value(value)); });
+        return result;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ShmRing.hpp"
+#include "assfire/messenger/api/Message.hpp"
+#include "assfire/messenger/api/RecordHeaders.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace assfire::messenger {
+    // Message read from a shared memory ring, holding its slot for as long as any message refers to payload or headers.
+    // Slot is released back to writers on destruction, so payload and headers are read in place without copying.
+    // Slot bytes are: payload size, key size (UINT32_MAX when there is no key), headers count as 32-bit integers,
+    // then key bytes, then name size, value size, name and value of every header, then payload bytes
+    class ShmRecord : public RecordHeaders {
+      public:
+        // Data must be valid as checked by is_valid
+        ShmRecord(std::shared_ptr<ShmRing> ring, std::uint64_t position, const std::uint8_t* data, std::uint32_t size);
+        ~ShmRecord();
+        ShmRecord(const ShmRecord& rhs) = delete;
+
+        ShmRecord& operator=(const ShmRecord& rhs) = delete;
+
+        static std::size_t encoded_size(const Message& msg);
+        // Output must have room for encoded_size bytes
+        static void encode(const Message& msg, std::uint8_t* out);
+        // True if key, headers and payload sizes encoded in data add up to its size
+        static bool is_valid(const std::uint8_t* data, std::uint32_t size);
+
+        std::uint64_t position() const {
+            return _position;
+        }
+
+        const std::uint8_t* payload_data() const {
+            return _payload_data;
+        }
+
+        std::size_t payload_size() const {
+            return _payload_size;
+        }
+
+        const std::optional<std::string_view>& key() const {
+            return _key;
+        }
+
+        virtual std::optional<std::string_view> find(std::string_view id) const override;
+        virtual std::vector<Header> to_headers() const override;
+
+      private:
+        template <typename Visitor>
+        void for_each_header(Visitor visit) const;
+
+        std::shared_ptr<ShmRing> _ring;
+        std::uint64_t _position;
+        const std::uint8_t* _headers_data;
+        std::uint32_t _headers_count;
+        const std::uint8_t* _payload_data;
+        std::size_t _payload_size;
+        std::optional<std::string_view> _key;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
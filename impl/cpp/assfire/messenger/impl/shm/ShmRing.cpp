@@ -0,0 +1,192 @@
+#include "ShmRing.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace assfire::messenger {
+
+    struct ShmRing::Header {
+        std::atomic<std::uint64_t> magic;
+        std::uint64_t slot_count;
+        std::uint32_t slot_size;
+        alignas(64) std::atomic<std::uint64_t> enqueue_pos;
+        alignas(64) std::atomic<std::uint64_t> dequeue_pos;
+        alignas(64) std::atomic<std::uint32_t> readable_epoch;
+        std::atomic<std::uint32_t> readable_waiters;
+        alignas(64) std::atomic<std::uint32_t> writable_epoch;
+        std::atomic<std::uint32_t> writable_waiters;
+    };
+
+    struct ShmRing::SlotHeader {
+        std::atomic<std::uint64_t> sequence;
+        std::uint32_t record_size;
+    };
+
+    namespace {
+        // Layout version is part of the magic, so processes built with different layouts refuse each other's segments
+        constexpr std::uint64_t MAGIC = 0x4153534652494e01;
+        // Opening process waits this long for creating process to size and initialize the segment
+        constexpr std::chrono::milliseconds INIT_TIMEOUT = std::chrono::seconds(5);
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+                      "Atomics shared between processes must be lock-free");
+
+        constexpr std::size_t align_up(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        std::string posix_name(const std::string& segment_name) {
+            return segment_name.starts_with("/") ? segment_name : "/" + segment_name;
+        }
+
+        [[noreturn]] void throw_errno(const std::string& what, const std::string& segment_name) {
+            throw std::runtime_error(what + " " + segment_name + ": " + std::strerror(errno));
+        }
+
+        template <typename Predicate>
+        bool wait_for_init(Predicate ready) {
+            auto deadline = std::chrono::steady_clock::now() + INIT_TIMEOUT;
+            while (!ready()) {
+                if (std::chrono::steady_clock::now() >= deadline) { return false; }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return true;
+        }
+    } // namespace
+
+    ShmRing::ShmRing(std::string segment_name, std::uint64_t slot_count, std::uint32_t slot_size)
+        : _segment_name(posix_name(segment_name)),
+          _slot_count(std::bit_ceil(std::max<std::uint64_t>(slot_count, 2))),
+          _slot_size(slot_size),
+          _slot_stride(align_up(sizeof(SlotHeader) + slot_size, 64)),
+          _mapping_size(align_up(sizeof(Header), 64) + _slot_stride * _slot_count) {
+        int fd       = shm_open(_segment_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        bool created = fd >= 0;
+        if (!created) {
+            if (errno != EEXIST) { throw_errno("Failed to create shared memory segment", _segment_name); }
+            fd = shm_open(_segment_name.c_str(), O_RDWR, 0);
+            if (fd < 0) { throw_errno("Failed to open shared memory segment", _segment_name); }
+        }
+
+        if (created) {
+            if (ftruncate(fd, static_cast<off_t>(_mapping_size)) != 0) {
+                close(fd);
+                shm_unlink(_segment_name.c_str());
+                throw_errno("Failed to size shared memory segment", _segment_name);
+            }
+        } else {
+            struct stat st {};
+            bool sized = wait_for_init([&] { return fstat(fd, &st) == 0 && st.st_size > 0; });
+            if (!sized || static_cast<std::size_t>(st.st_size) != _mapping_size) {
+                close(fd);
+                throw std::runtime_error("Shared memory segment " + _segment_name + " has different layout or wasn't initialized");
+            }
+        }
+
+        _mapping = mmap(nullptr, _mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (_mapping == MAP_FAILED) { throw_errno("Failed to map shared memory segment", _segment_name); }
+        _header = static_cast<Header*>(_mapping);
+        _slots  = static_cast<std::uint8_t*>(_mapping) + align_up(sizeof(Header), 64);
+
+        if (created) {
+            // Fresh segment is zero-filled, so only non-zero fields are set before magic publishes the layout
+            new (_header) Header();
+            _header->slot_count = _slot_count;
+            _header->slot_size  = _slot_size;
+            for (std::uint64_t i = 0; i < _slot_count; ++i) {
+                new (&slot(i)) SlotHeader();
+                slot(i).sequence.store(i, std::memory_order_relaxed);
+            }
+            _header->magic.store(MAGIC, std::memory_order_release);
+        } else if (!wait_for_init([&] { return _header->magic.load(std::memory_order_acquire) == MAGIC; }) ||
+                   _header->slot_count != _slot_count || _header->slot_size != _slot_size) {
+            munmap(_mapping, _mapping_size);
+            throw std::runtime_error("Shared memory segment " + _segment_name + " has different layout or wasn't initialized");
+        }
+
+        _readable_notifier = std::make_unique<WakeupNotifier>(_header->readable_epoch, _header->readable_waiters);
+        _writable_notifier = std::make_unique<WakeupNotifier>(_header->writable_epoch, _header->writable_waiters);
+    }
+
+    ShmRing::~ShmRing() {
+        munmap(_mapping, _mapping_size);
+    }
+
+    void ShmRing::unlink(const std::string& segment_name) {
+        shm_unlink(posix_name(segment_name).c_str());
+    }
+
+    std::uint8_t* ShmRing::try_claim_write(std::uint64_t& position) {
+        std::uint64_t pos = _header->enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            std::uint64_t seq     = slot(pos).sequence.load(std::memory_order_acquire);
+            std::int64_t distance = static_cast<std::int64_t>(seq - pos);
+            if (distance == 0) {
+                if (_header->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+            } else if (distance < 0) {
+                return nullptr;
+            } else {
+                pos = _header->enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        position = pos;
+        return reinterpret_cast<std::uint8_t*>(&slot(pos)) + sizeof(SlotHeader);
+    }
+
+    void ShmRing::commit_write(std::uint64_t position, std::uint32_t record_size) {
+        slot(position).record_size = record_size;
+        slot(position).sequence.store(position + 1, std::memory_order_release);
+        // Waiter woken by a single wakeup may be paused or be a watcher that only schedules handlers, so every waiter is woken to recheck
+        _readable_notifier->notify_all();
+    }
+
+    const std::uint8_t* ShmRing::try_claim_read(std::uint64_t& position, std::uint32_t& record_size) {
+        std::uint64_t pos = _header->dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            std::uint64_t seq     = slot(pos).sequence.load(std::memory_order_acquire);
+            std::int64_t distance = static_cast<std::int64_t>(seq - (pos + 1));
+            if (distance == 0) {
+                if (_header->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+            } else if (distance < 0) {
+                return nullptr;
+            } else {
+                pos = _header->dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        position    = pos;
+        record_size = slot(pos).record_size;
+        return reinterpret_cast<const std::uint8_t*>(&slot(pos)) + sizeof(SlotHeader);
+    }
+
+    void ShmRing::release_read(std::uint64_t position) {
+        slot(position).sequence.store(position + _slot_count, std::memory_order_release);
+        _writable_notifier->notify_all();
+    }
+
+    bool ShmRing::empty() const {
+        std::uint64_t pos = _header->dequeue_pos.load(std::memory_order_acquire);
+        std::uint64_t seq = slot(pos).sequence.load(std::memory_order_acquire);
+        return static_cast<std::int64_t>(seq - (pos + 1)) < 0;
+    }
+
+    bool ShmRing::full() const {
+        std::uint64_t pos = _header->enqueue_pos.load(std::memory_order_acquire);
+        std::uint64_t seq = slot(pos).sequence.load(std::memory_order_acquire);
+        return static_cast<std::int64_t>(seq - pos) < 0;
+    }
+
+    ShmRing::SlotHeader& ShmRing::slot(std::uint64_t position) const {
+        return *reinterpret_cast<SlotHeader*>(_slots + (position & (_slot_count - 1)) * _slot_stride);
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "assfire/messenger/impl/util/WakeupNotifier.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace assfire::messenger {
+    // Bounded MPMC ring of fixed-size slots in a named POSIX shared memory segment (/dev/shm on Linux), usable by any number
+    // of processes mapping the same segment. Slots are claimed with Vyukov's sequence protocol like in MpmcRingBuffer,
+    // but a read slot is released only when its reader is done with it, so readers may use slot bytes in place.
+    // Waiting for data or free slots parks on futex words placed in the segment itself.
+    // Process which dies between claiming and committing or releasing a slot leaves it stuck, blocking the ring once it wraps
+    class ShmRing {
+      public:
+        // Maps segment, creating and initializing it if it doesn't exist yet. Existing segment must have the same slot layout.
+        // Throws std::runtime_error if segment can't be created or mapped, or if its layout differs
+        ShmRing(std::string segment_name, std::uint64_t slot_count, std::uint32_t slot_size);
+        ~ShmRing();
+        ShmRing(const ShmRing& rhs) = delete;
+
+        ShmRing& operator=(const ShmRing& rhs) = delete;
+
+        // Removes segment name, mappings that already exist stay valid
+        static void unlink(const std::string& segment_name);
+
+        // Returns nullptr if ring is full. Claimed slot must be committed with its position
+        std::uint8_t* try_claim_write(std::uint64_t& position);
+        void commit_write(std::uint64_t position, std::uint32_t record_size);
+
+        // Returns nullptr if ring is empty. Claimed slot stays unavailable to writers until it is released
+        const std::uint8_t* try_claim_read(std::uint64_t& position, std::uint32_t& record_size);
+        void release_read(std::uint64_t position);
+
+        bool empty() const;
+        bool full() const;
+
+        // Notified by writers on every committed message
+        WakeupNotifier& readable_notifier() {
+            return *_readable_notifier;
+        }
+
+        // Notified by readers on every released slot
+        WakeupNotifier& writable_notifier() {
+            return *_writable_notifier;
+        }
+
+        const std::string& segment_name() const {
+            return _segment_name;
+        }
+
+        std::uint64_t slot_count() const {
+            return _slot_count;
+        }
+
+        std::uint32_t slot_size() const {
+            return _slot_size;
+        }
+
+      private:
+        struct Header;
+        struct SlotHeader;
+
+        SlotHeader& slot(std::uint64_t position) const;
+
+        std::string _segment_name;
+        std::uint64_t _slot_count;
+        std::uint32_t _slot_size;
+        std::size_t _slot_stride;
+        std::size_t _mapping_size;
+        void* _mapping;
+        Header* _header;
+        std::uint8_t* _slots;
+        std::unique_ptr<WakeupNotifier> _readable_notifier;
+        std::unique_ptr<WakeupNotifier> _writable_notifier;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "assfire/logger/impl/spdlog/SpdlogLoggerFactory.hpp"
+#include "assfire/messenger/impl/shm/ShmMessenger.hpp"
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+namespace {
+    ShmChannelOptions channel_options() {
+        ShmChannelOptions options;
+        options.set_segment_name("assfire.messenger.benchmark." + std::to_string(getpid()));
+        options.set_slot_count(4096);
+        options.set_slot_size(1024);
+        return options;
+    }
+} // namespace
+
+// Publish and poll of one message on the same thread - the cost of encoding a message into a slot and reading it in place
+static void ShmMessenger_PublishPoll(benchmark::State& state) {
+    assfire::logger::SpdlogLoggerFactory::register_static_factory();
+    ShmChannelOptions options = channel_options();
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel"), options);
+    auto publisher = messenger.get_publisher(ChannelId("channel"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel"));
+
+    Message msg(pack(std::string(state.range(0), 'x')));
+    msg.add_header(Header("header", "value"));
+    for (auto _ : state) {
+        publisher->publish(msg);
+        benchmark::DoNotOptimize(consumer->poll(1s));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+
+    messenger.destroy_channel(ChannelId("channel"));
+    ShmMessenger::unlink_channel(ChannelId("channel"), options);
+}
+
+BENCHMARK(ShmMessenger_PublishPoll)->Arg(16)->Arg(512);
\ No newline at end of file
@@ -0,0 +1,299 @@
+#include "assfire/logger/impl/spdlog/SpdlogLoggerFactory.hpp"
+#include "assfire/messenger/api/Exceptions.hpp"
+#include "assfire/messenger/impl/shm/ShmMessenger.hpp"
+#include "assfire/messenger/impl/shm/ShmRing.hpp"
+
+#include <condition_variable>
+#include <cstring>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_set>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+using ShmMessage = assfire::messenger::Message;
+
+class ShmMessengerTest : public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        assfire::logger::SpdlogLoggerFactory::register_static_factory();
+    }
+
+    void SetUp() override {
+        options.set_segment_name("assfire.messenger.test." + std::to_string(getpid()));
+        options.set_slot_count(8);
+        options.set_slot_size(256);
+        ShmMessenger::unlink_channel(ChannelId("channel1"), options);
+    }
+
+    void TearDown() override {
+        ShmMessenger::unlink_channel(ChannelId("channel1"), options);
+    }
+
+    ShmChannelOptions options;
+};
+
+TEST_F(ShmMessengerTest, Messenger_MessagesAreSentAndReceivedInOrder) {
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"), options);
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    EXPECT_THROW(consumer->poll(10ms), TimeoutError);
+
+    publisher->publish(ShmMessage(pack("Test message 1")));
+    publisher->publish(ShmMessage(pack("Test message 2")));
+
+    ShmMessage received_msg1 = consumer->poll(1s);
+    ShmMessage received_msg2 = consumer->poll(1s);
+
+    EXPECT_EQ(to_string_view(received_msg1.payload()), "Test message 1");
+    EXPECT_EQ(to_string_view(received_msg2.payload()), "Test message 2");
+    ASSERT_TRUE(received_msg1.delivery_metadata());
+    EXPECT_EQ(received_msg1.delivery_metadata()->topic(), "channel1");
+    EXPECT_EQ(received_msg1.delivery_metadata()->offset(), 0);
+    EXPECT_EQ(received_msg2.delivery_metadata()->offset(), 1);
+
+    consumer->ack(received_msg1);
+    consumer->ack(received_msg2);
+}
+
+TEST_F(ShmMessengerTest, Messenger_UndeclaredChannelCannotBeUsed) {
+    ShmMessenger messenger;
+
+    EXPECT_THROW(messenger.get_publisher(ChannelId("channel1")), ChannelNotDeclaredError);
+    EXPECT_THROW(messenger.get_consumer(ChannelId("channel1")), ChannelNotDeclaredError);
+}
+
+TEST_F(ShmMessengerTest, Messenger_RedeclarationOfChannelWithDifferentOptionsIsNotAllowed) {
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"), options);
+
+    EXPECT_NO_THROW(messenger.create_channel(ChannelId("channel1"), options));
+
+    ShmChannelOptions other_options = options;
+    other_options.set_slot_size(512);
+    EXPECT_THROW(messenger.create_channel(ChannelId("channel1"), other_options), ChannelRedeclarationAttemptError);
+}
+
+TEST_F(ShmMessengerTest, Messenger_SegmentWithDifferentLayoutCannotBeAttached) {
+    ShmMessenger messenger1;
+    ShmMessenger messenger2;
+    messenger1.create_channel(ChannelId("channel1"), options);
+
+    ShmChannelOptions other_options = options;
+    other_options.set_slot_count(16);
+    EXPECT_THROW(messenger2.create_channel(ChannelId("channel1"), other_options), ConsumerConstructionError);
+    EXPECT_THROW(messenger2.get_consumer(ChannelId("channel1")), ChannelNotDeclaredError);
+}
+
+TEST_F(ShmMessengerTest, Messenger_MessengersAttachedToSameSegmentShareMessages) {
+    ShmMessenger messenger1;
+    ShmMessenger messenger2;
+    messenger1.create_channel(ChannelId("channel1"), options);
+    messenger2.create_channel(ChannelId("channel1"), options);
+
+    ShmMessage msg(pack("Test message"));
+    msg.set_key("key1");
+    msg.add_header(Header("header1", "value1"));
+    msg.add_header(Header("header2", ""));
+    messenger1.get_publisher(ChannelId("channel1"))->publish(msg);
+
+    ShmMessage received_msg = messenger2.get_consumer(ChannelId("channel1"))->poll(1s);
+    EXPECT_EQ(to_string_view(received_msg.payload()), "Test message");
+    EXPECT_EQ(received_msg.key(), "key1");
+    EXPECT_EQ(received_msg.header_view("header1"), "value1");
+    EXPECT_EQ(received_msg.header_view("header2"), "");
+    EXPECT_FALSE(received_msg.header_view("header3"));
+
+    EXPECT_THROW(messenger1.get_consumer(ChannelId("channel1"))->poll(10ms), TimeoutError);
+}
+
+TEST_F(ShmMessengerTest, Messenger_MessageNotFittingIntoSlotIsRejected) {
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"), options);
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+
+    EXPECT_THROW(publisher->publish(ShmMessage(pack(std::string(options.slot_size(), 'x')))), PublisherError);
+
+    std::optional<DeliveryReport> report;
+    publisher->publish(ShmMessage(pack(std::string(options.slot_size(), 'x'))), [&](const DeliveryReport& r) { report = r; });
+    ASSERT_TRUE(report);
+    EXPECT_FALSE(report->ok());
+}
+
+TEST_F(ShmMessengerTest, Messenger_CorruptedRecordsAreDropped) {
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"), options);
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    // Another process writing to the segment may commit anything, i.e. sizes pointing past the slot
+    ShmRing ring(*options.segment_name(), options.slot_count(), options.slot_size());
+    auto write_raw = [&](std::initializer_list<std::uint32_t> words, std::uint32_t record_size) {
+        std::uint64_t position = 0;
+        std::uint8_t* slot     = ring.try_claim_write(position);
+        ASSERT_NE(slot, nullptr);
+        std::uint8_t* out = slot;
+        for (std::uint32_t word : words) {
+            std::memcpy(out, &word, sizeof(word));
+            out += sizeof(word);
+        }
+        ring.commit_write(position, record_size);
+    };
+    write_raw({1000, UINT32_MAX, 0}, 12);
+    write_raw({0, 100, 0}, 12);
+    write_raw({0, UINT32_MAX, 5, 1, 1}, 20);
+    write_raw({0, UINT32_MAX, 0}, options.slot_size() + 1);
+    publisher->publish(ShmMessage(pack("Test message")));
+
+    ShmMessage received_msg = consumer->poll(1s);
+    EXPECT_EQ(to_string_view(received_msg.payload()), "Test message");
+    EXPECT_EQ(received_msg.delivery_metadata()->offset(), 4);
+}
+
+TEST_F(ShmMessengerTest, Messenger_PolledMessagesHoldTheirSlots) {
+    options.set_publish_timeout(10ms);
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"), options);
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    std::vector<ShmMessage> held;
+    for (std::size_t i = 0; i < options.slot_count(); ++i) {
+        publisher->publish(ShmMessage(pack("Test message " + std::to_string(i))));
+        held.push_back(consumer->poll(1s));
+    }
+
+    EXPECT_THROW(publisher->publish(ShmMessage(pack("Test message"))), PublisherError);
+    EXPECT_EQ(to_string_view(held.front().payload()), "Test message 0");
+
+    held.erase(held.begin());
+    EXPECT_NO_THROW(publisher->publish(ShmMessage(pack("Test message"))));
+}
+
+TEST_F(ShmMessengerTest, Messenger_PublisherIsBlockedWhileChannelIsFull) {
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"), options);
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+    auto consumer  = messenger.get_consumer(ChannelId("channel1"));
+
+    for (std::size_t i = 0; i < options.slot_count(); ++i) {
+        publisher->publish(ShmMessage(pack("Test message " + std::to_string(i))));
+    }
+
+    std::atomic_bool published = false;
+    std::thread publishing_thread([&] {
+        publisher->publish(ShmMessage(pack("Last message")));
+        published = true;
+    });
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(published);
+
+    for (std::size_t i = 0; i <= options.slot_count(); ++i) {
+        consumer->poll(1s);
+    }
+    publishing_thread.join();
+    EXPECT_TRUE(published);
+}
+
+TEST_F(ShmMessengerTest, Messenger_SubscribedHandlerReceivesMessages) {
+    ShmMessenger messenger;
+    messenger.create_channel(ChannelId("channel1"), options);
+
+    auto publisher = messenger.get_publisher(ChannelId("channel1"));
+
+    std::mutex mtx;
+    std::condition_variable handled_cv;
+    std::unordered_set<std::string> messages;
+
+    messenger.subscribe(
+        ChannelId("channel1"),
+        [&](const ShmMessage& msg) {
+            std::lock_guard<std::mutex> lck(mtx);
+            messages.emplace(to_string_view(msg.payload()));
+            handled_cv.notify_all();
+        },
+        2);
+
+    publisher->publish(ShmMessage(pack("Test message 1")));
+    publisher->publish(ShmMessage(pack("Test message 2")));
+    publisher->publish(ShmMessage(pack("Test message 3")));
+
+    std::unique_lock<std::mutex> lck(mtx);
+    ASSERT_TRUE(handled_cv.wait_for(lck, 30s, [&] { return messages.size() == 3; }));
+    lck.unlock();
+
+    messenger.destroy_channel(ChannelId("channel1"));
+}
+
+TEST_F(ShmMessengerTest, Messenger_ConsumerIsStoppedFromSubscribedHandler) {
+    ShmMessenger messenger;
+    auto consumer = messenger.create_channel(ChannelId("channel1"), options);
+
+    std::promise<void> stopped;
+    std::atomic_bool stop_called(false);
+    messenger.subscribe(ChannelId("channel1"), [&](const ShmMessage& msg) {
+        if (stop_called.exchange(true)) { return; }
+        consumer->stop();
+        stopped.set_value();
+    });
+
+    messenger.get_publisher(ChannelId("channel1"))->publish(ShmMessage(pack("Test message")));
+
+    EXPECT_EQ(stopped.get_future().wait_for(10s), std::future_status::ready);
+    EXPECT_TRUE(consumer->stopped());
+}
+
+TEST_F(ShmMessengerTest, Messenger_ConsumerIsStoppedFromReadableCallback) {
+    ShmMessenger messenger;
+    auto consumer = messenger.create_channel(ChannelId("channel1"), options);
+
+    std::promise<void> stopped;
+    consumer->notify_when_readable([&] {
+        consumer->stop();
+        stopped.set_value();
+    });
+
+    messenger.get_publisher(ChannelId("channel1"))->publish(ShmMessage(pack("Test message")));
+
+    EXPECT_EQ(stopped.get_future().wait_for(10s), std::future_status::ready);
+}
+
+TEST_F(ShmMessengerTest, Messenger_MessagesArePassedBetweenProcesses) {
+    ShmMessenger messenger;
+    auto consumer = messenger.create_channel(ChannelId("channel1"), options);
+
+    constexpr int count = 100;
+    pid_t pid           = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        int status = 0;
+        try {
+            ShmMessenger child_messenger;
+            child_messenger.create_channel(ChannelId("channel1"), options);
+            auto publisher = child_messenger.get_publisher(ChannelId("channel1"));
+            for (int i = 0; i < count; ++i) {
+                publisher->publish(ShmMessage(pack("Test message " + std::to_string(i))));
+            }
+        } catch (...) { status = 1; }
+        _exit(status);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(to_string_view(consumer->poll(10s).payload()), "Test message " + std::to_string(i));
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "BufferPool.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace assfire::messenger {
+
+    std::shared_ptr<BufferPool> BufferPool::create(std::size_t max_cached_blocks) {
+        return std::shared_ptr<BufferPool>(new BufferPool(max_cached_blocks), [](BufferPool* pool) { pool->release(); });
+    }
+
+    BufferPool::BufferPool(std::size_t max_cached_blocks)
+        : _heap_allocations(0),
+          _references(1) {
+        for (auto& free_list : _free_lists) {
+            free_list = std::make_unique<MpmcRingBuffer<void*>>(max_cached_blocks);
+        }
+    }
+
+    // Blocks keep the pool alive, so all of them are back in free lists or on the heap by now
+    BufferPool::~BufferPool() {
+        std::uint64_t position;
+        void* block;
+        for (auto& free_list : _free_lists) {
+            while (free_list->try_pop(block, position)) {
+                ::operator delete(block);
+            }
+        }
+    }
+
+    void* BufferPool::allocate(std::size_t size) {
+        if (size > max_block_size) { return ::operator new(size); }
+
+        std::size_t cls = size_class(size);
+        std::uint64_t position;
+        void* block;
+        if (!_free_lists[cls]->try_pop(block, position)) {
+            block = ::operator new(min_block_size << cls);
+            _heap_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        _references.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    void BufferPool::deallocate(void* block, std::size_t size) noexcept {
+        if (size > max_block_size) {
+            ::operator delete(block);
+            return;
+        }
+        std::uint64_t position;
+        if (!_free_lists[size_class(size)]->try_push(block, position)) { ::operator delete(block); }
+        release();
+    }
+
+    std::size_t BufferPool::cached_blocks() const {
+        std::size_t result = 0;
+        for (const auto& free_list : _free_lists) {
+            result += free_list->size();
+        }
+        return result;
+    }
+
+    void BufferPool::release() noexcept {
+        if (_references.fetch_sub(1, std::memory_order_acq_rel) == 1) { delete this; }
+    }
+
+    std::size_t BufferPool::size_class(std::size_t size) {
+        return static_cast<std::size_t>(std::countr_zero(std::bit_ceil(std::max(size, min_block_size)) / min_block_size));
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "MpmcRingBuffer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace assfire::messenger {
+    // Size-classed free lists of heap blocks. Blocks are rounded up to a power of two between min and max block size and
+    // returned to the free list of their class when released, so steady stream of same-sized allocations stops hitting
+    // malloc once free lists are warm. Free lists are lock-free, blocks may be allocated and released on different threads.
+    // Blocks above max block size and blocks released to a full free list go straight to the heap.
+    // Every block holds a reference to the pool, so the pool is destroyed once its owner and all its blocks release it
+    class BufferPool {
+      public:
+        static constexpr std::size_t min_block_size = 64;
+        static constexpr std::size_t max_block_size = 4096;
+
+        // Every size class caches at most max_cached_blocks released blocks
+        static std::shared_ptr<BufferPool> create(std::size_t max_cached_blocks);
+
+        BufferPool(const BufferPool& rhs) = delete;
+
+        BufferPool& operator=(const BufferPool& rhs) = delete;
+
+        // Blocks are aligned as by operator new
+        void* allocate(std::size_t size);
+        void deallocate(void* block, std::size_t size) noexcept;
+
+        // Number of blocks allocated on the heap because free list of their class was empty
+        std::uint64_t heap_allocations() const {
+            return _heap_allocations.load(std::memory_order_relaxed);
+        }
+
+        // Approximate while blocks are allocated or released
+        std::size_t cached_blocks() const;
+
+      private:
+        static constexpr std::size_t classes_count = 7;
+        static_assert(min_block_size << (classes_count - 1) == max_block_size);
+
+        explicit BufferPool(std::size_t max_cached_blocks);
+        ~BufferPool();
+
+        static std::size_t size_class(std::size_t size);
+        void release() noexcept;
+
+        std::array<std::unique_ptr<MpmcRingBuffer<void*>>, classes_count> _free_lists;
+        std::atomic<std::uint64_t> _heap_allocations;
+        // Owner's reference and one per allocated block
+        std::atomic<std::size_t> _references;
+    };
+
+    // Standard allocator drawing from a buffer pool, e.g. for std::allocate_shared. Allocated blocks keep the pool alive,
+    // so objects allocated from it may outlive the pool's owner. Allocator itself doesn't, as containers copy allocators
+    // often and pool's reference count would be updated for every copy
+    template <typename T>
+    class PoolAllocator {
+      public:
+        using value_type = T;
+
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Pooled blocks are aligned as by operator new");
+
+        // Must be used for allocation only while pool is owned by someone
+        explicit PoolAllocator(BufferPool* pool) : _pool(pool) {}
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>& rhs) : _pool(rhs.pool()) {}
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U>& rhs) const {
+            return _pool == rhs.pool();
+        }
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(_pool->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            _pool->deallocate(p, n * sizeof(T));
+        }
+
+        BufferPool* pool() const {
+            return _pool;
+        }
+
+      private:
+        BufferPool* _pool;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
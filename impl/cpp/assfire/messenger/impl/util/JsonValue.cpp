@@ -0,0 +1,273 @@
+#include "JsonValue.hpp"
+
+#include <charconv>
+#include <stdexcept>
+
+namespace assfire::messenger {
+
+    namespace {
+        // Parser recurses into nested values, so nesting is limited to keep malformed documents from overflowing the stack
+        constexpr std::size_t MAX_DEPTH = 64;
+    } // namespace
+
+    class JsonValue::Parser {
+      public:
+        explicit Parser(std::string_view text) : _text(text) {}
+
+        JsonValue parse_document() {
+            JsonValue result = parse_value();
+            skip_whitespace();
+            if (_pos != _text.size()) { fail("unexpected trailing characters"); }
+            return result;
+        }
+
+      private:
+        JsonValue parse_value() {
+            skip_whitespace();
+            if (_pos >= _text.size()) { fail("unexpected end of document"); }
+
+            JsonValue result;
+            switch (_text[_pos]) {
+                case '{':
+                    enter();
+                    result._value = parse_object();
+                    --_depth;
+                    break;
+                case '[':
+                    enter();
+                    result._value = parse_array();
+                    --_depth;
+                    break;
+                case '"': result._value = parse_string(); break;
+                case 't':
+                    expect_literal("true");
+                    result._value = true;
+                    break;
+                case 'f':
+                    expect_literal("false");
+                    result._value = false;
+                    break;
+                case 'n':
+                    expect_literal("null");
+                    result._value = nullptr;
+                    break;
+                default: parse_number(result); break;
+            }
+            return result;
+        }
+
+        Object parse_object() {
+            Object result;
+            ++_pos;
+            skip_whitespace();
+            if (consume('}')) { return result; }
+            do {
+                skip_whitespace();
+                if (_pos >= _text.size() || _text[_pos] != '"') { fail("expected member name"); }
+                std::string key = parse_string();
+                skip_whitespace();
+                if (!consume(':')) { fail("expected ':'"); }
+                result.emplace_back(std::move(key), parse_value());
+                skip_whitespace();
+            } while (consume(','));
+            if (!consume('}')) { fail("expected '}'"); }
+            return result;
+        }
+
+        Array parse_array() {
+            Array result;
+            ++_pos;
+            skip_whitespace();
+            if (consume(']')) { return result; }
+            do {
+                result.push_back(parse_value());
+                skip_whitespace();
+            } while (consume(','));
+            if (!consume(']')) { fail("expected ']'"); }
+            return result;
+        }
+
+        std::string parse_string() {
+            std::string result;
+            ++_pos;
+            while (_pos < _text.size() && _text[_pos] != '"') {
+                char c = _text[_pos++];
+                if (c != '\\') {
+                    result.push_back(c);
+                    continue;
+                }
+                if (_pos >= _text.size()) { break; }
+                switch (char escaped = _text[_pos++]) {
+                    case 'b': result.push_back('\b'); break;
+                    case 'f': result.push_back('\f'); break;
+                    case 'n': result.push_back('\n'); break;
+                    case 'r': result.push_back('\r'); break;
+                    case 't': result.push_back('\t'); break;
+                    case 'u': append_utf8(result, parse_code_point()); break;
+                    default: result.push_back(escaped); break;
+                }
+            }
+            if (!consume('"')) { fail("unterminated string"); }
+            return result;
+        }
+
+        std::uint32_t parse_code_point() {
+            std::uint32_t code_point = parse_hex4();
+            // Characters outside of basic plane are encoded as surrogate pair
+            if (code_point >= 0xD800 && code_point <= 0xDBFF && _text.substr(_pos, 2) == "\\u") {
+                _pos += 2;
+                std::uint32_t low = parse_hex4();
+                code_point        = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+            }
+            return code_point;
+        }
+
+        std::uint32_t parse_hex4() {
+            std::uint32_t result = 0;
+            if (_pos + 4 > _text.size() || std::from_chars(_text.data() + _pos, _text.data() + _pos + 4, result, 16).ptr != _text.data() + _pos + 4) {
+                fail("invalid unicode escape");
+            }
+            _pos += 4;
+            return result;
+        }
+
+        static void append_utf8(std::string& out, std::uint32_t code_point) {
+            if (code_point < 0x80) {
+                out.push_back(static_cast<char>(code_point));
+            } else if (code_point < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+                out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            } else if (code_point < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+        }
+
+        void parse_number(JsonValue& result) {
+            std::size_t start = _pos;
+            bool integral     = true;
+            if (_pos < _text.size() && _text[_pos] == '-') { ++_pos; }
+            while (_pos < _text.size()) {
+                char c = _text[_pos];
+                if (c == '.' || c == 'e' || c == 'E' || c == '+' || (c == '-' && _pos > start)) {
+                    integral = false;
+                } else if (c < '0' || c > '9') {
+                    break;
+                }
+                ++_pos;
+            }
+
+            const char* first = _text.data() + start;
+            const char* last  = _text.data() + _pos;
+            if (integral) {
+                std::int64_t value = 0;
+                auto [ptr, ec]     = std::from_chars(first, last, value);
+                if (ec == std::errc() && ptr == last) {
+                    result._value = value;
+                    return;
+                }
+            }
+            // Integers that overflow int64 are kept as double as well
+            try {
+                std::size_t parsed = 0;
+                result._value      = std::stod(std::string(first, last), &parsed);
+                if (parsed == static_cast<std::size_t>(last - first) && last != first) { return; }
+            } catch (const std::exception&) {}
+            fail("invalid number");
+        }
+
+        void expect_literal(std::string_view literal) {
+            if (_text.substr(_pos, literal.size()) != literal) { fail("invalid literal"); }
+            _pos += literal.size();
+        }
+
+        void enter() {
+            if (++_depth > MAX_DEPTH) { fail("nesting is deeper than " + std::to_string(MAX_DEPTH) + " levels"); }
+        }
+
+        bool consume(char c) {
+            if (_pos < _text.size() && _text[_pos] == c) {
+                ++_pos;
+                return true;
+            }
+            return false;
+        }
+
+        void skip_whitespace() {
+            while (_pos < _text.size() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' || _text[_pos] == '\r')) {
+                ++_pos;
+            }
+        }
+
+        [[noreturn]] void fail(const std::string& reason) const {
+            throw std::invalid_argument("Invalid JSON at position " + std::to_string(_pos) + ": " + reason);
+        }
+
+        std::string_view _text;
+        std::size_t _pos   = 0;
+        std::size_t _depth = 0;
+    };
+
+    JsonValue JsonValue::parse(std::string_view text) {
+        return Parser(text).parse_document();
+    }
+
+    const JsonValue* JsonValue::find(std::string_view key) const {
+        const Object* object = std::get_if<Object>(&_value);
+        if (!object) { return nullptr; }
+        for (const auto& [name, value] : *object) {
+            if (name == key) { return &value; }
+        }
+        return nullptr;
+    }
+
+    const JsonValue* JsonValue::find_path(std::initializer_list<std::string_view> path) const {
+        const JsonValue* current = this;
+        for (std::string_view key : path) {
+            current = current->find(key);
+            if (!current) { return nullptr; }
+        }
+        return current;
+    }
+
+    std::int64_t JsonValue::as_int(std::int64_t fallback) const {
+        if (const std::int64_t* value = std::get_if<std::int64_t>(&_value)) { return *value; }
+        if (const double* value = std::get_if<double>(&_value)) { return static_cast<std::int64_t>(*value); }
+        return fallback;
+    }
+
+    double JsonValue::as_double(double fallback) const {
+        if (const double* value = std::get_if<double>(&_value)) { return *value; }
+        if (const std::int64_t* value = std::get_if<std::int64_t>(&_value)) { return static_cast<double>(*value); }
+        return fallback;
+    }
+
+    bool JsonValue::as_bool(bool fallback) const {
+        if (const bool* value = std::get_if<bool>(&_value)) { return *value; }
+        return fallback;
+    }
+
+    std::string_view JsonValue::as_string(std::string_view fallback) const {
+        if (const std::string* value = std::get_if<std::string>(&_value)) { return *value; }
+        return fallback;
+    }
+
+    const JsonValue::Object& JsonValue::members() const {
+        static const Object empty;
+        const Object* object = std::get_if<Object>(&_value);
+        return object ? *object : empty;
+    }
+
+    const JsonValue::Array& JsonValue::elements() const {
+        static const Array empty;
+        const Array* array = std::get_if<Array>(&_value);
+        return array ? *array : empty;
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
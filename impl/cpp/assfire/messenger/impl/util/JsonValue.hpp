@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace assfire::messenger {
+    // Minimal read-only JSON document, just enough to read statistics reported by librdkafka.
+    // Integral numbers are kept as int64, so offsets don't lose precision
+    class JsonValue {
+      public:
+        using Array  = std::vector<JsonValue>;
+        using Object = std::vector<std::pair<std::string, JsonValue>>;
+
+        JsonValue() = default;
+        JsonValue(const JsonValue& rhs) = default;
+        JsonValue(JsonValue&& rhs)      = default;
+
+        JsonValue& operator=(const JsonValue& rhs) = default;
+        JsonValue& operator=(JsonValue&& rhs) = default;
+
+        // Throws std::invalid_argument if text isn't a valid JSON document or nests objects and arrays deeper than 64 levels
+        static JsonValue parse(std::string_view text);
+
+        bool is_null() const {
+            return std::holds_alternative<std::nullptr_t>(_value);
+        }
+
+        bool is_object() const {
+            return std::holds_alternative<Object>(_value);
+        }
+
+        bool is_array() const {
+            return std::holds_alternative<Array>(_value);
+        }
+
+        // Returns nullptr if value isn't an object or has no such member
+        const JsonValue* find(std::string_view key) const;
+
+        // Follows nested object members, i.e. find_path({"rtt", "p99"})
+        const JsonValue* find_path(std::initializer_list<std::string_view> path) const;
+
+        // Conversions return fallback if value has different type
+        std::int64_t as_int(std::int64_t fallback = 0) const;
+        double as_double(double fallback = 0) const;
+        bool as_bool(bool fallback = false) const;
+        std::string_view as_string(std::string_view fallback = {}) const;
+
+        // Empty for values that aren't objects or arrays
+        const Object& members() const;
+        const Array& elements() const;
+
+      private:
+        class Parser;
+
+        std::variant<std::nullptr_t, bool, std::int64_t, double, std::string, Array, Object> _value;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace assfire::messenger {
+
+    LatencySnapshot::LatencySnapshot(std::vector<std::uint64_t> buckets, std::chrono::microseconds total, std::chrono::microseconds max)
+        : _buckets(std::move(buckets)),
+          _total(total),
+          _max(max) {
+        for (std::uint64_t bucket : _buckets) {
+            _count += bucket;
+        }
+    }
+
+    std::chrono::microseconds LatencySnapshot::percentile(double percentile) const {
+        if (_count == 0) { return std::chrono::microseconds(0); }
+
+        double clamped     = std::clamp(percentile, 0.0, 100.0);
+        std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(_count))));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < _buckets.size(); ++i) {
+            seen += _buckets[i];
+            if (seen >= rank) {
+                // Recorded values never exceed max, so clamping also keeps the result within duration range
+                std::uint64_t upper_bound = std::min(LatencyHistogram::bucket_upper_bound(i), static_cast<std::uint64_t>(_max.count()));
+                return std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(upper_bound));
+            }
+        }
+        return _max;
+    }
+
+    void LatencyHistogram::record(std::chrono::microseconds latency) {
+        std::uint64_t value = latency.count() > 0 ? static_cast<std::uint64_t>(latency.count()) : 0;
+        _buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        _total.fetch_add(value, std::memory_order_relaxed);
+
+        std::uint64_t max = _max.load(std::memory_order_relaxed);
+        while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+    }
+
+    // Buckets are read one by one while recording may go on, so snapshot isn't atomic as a whole, but every bucket is consistent
+    LatencySnapshot LatencyHistogram::snapshot() const {
+        std::vector<std::uint64_t> buckets(BUCKETS);
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        }
+        return LatencySnapshot(std::move(buckets), std::chrono::microseconds(_total.load(std::memory_order_relaxed)),
+                               std::chrono::microseconds(_max.load(std::memory_order_relaxed)));
+    }
+
+    // Values below SUB_BUCKETS map to buckets one-to-one. Larger ones are indexed by their power of two range
+    // and by SUB_BUCKET_BITS bits following the highest set bit
+    std::size_t LatencyHistogram::bucket_index(std::uint64_t value) {
+        if (value < SUB_BUCKETS) { return static_cast<std::size_t>(value); }
+        std::size_t shift = static_cast<std::size_t>(std::bit_width(value)) - SUB_BUCKET_BITS - 1;
+        return (shift + 1) * SUB_BUCKETS + static_cast<std::size_t>((value >> shift) - SUB_BUCKETS);
+    }
+
+    std::uint64_t LatencyHistogram::bucket_upper_bound(std::size_t index) {
+        if (index < SUB_BUCKETS) { return index; }
+        std::size_t shift         = index / SUB_BUCKETS - 1;
+        std::uint64_t sub_bucket  = index % SUB_BUCKETS + SUB_BUCKETS;
+        std::uint64_t lower_bound = sub_bucket << shift;
+        return lower_bound + ((std::uint64_t(1) << shift) - 1);
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace assfire::messenger {
+    // Point-in-time copy of LatencyHistogram buckets
+    class LatencySnapshot {
+      public:
+        LatencySnapshot() = default;
+        LatencySnapshot(std::vector<std::uint64_t> buckets, std::chrono::microseconds total, std::chrono::microseconds max);
+        LatencySnapshot(const LatencySnapshot& rhs) = default;
+        LatencySnapshot(LatencySnapshot&& rhs)      = default;
+
+        LatencySnapshot& operator=(const LatencySnapshot& rhs) = default;
+        LatencySnapshot& operator=(LatencySnapshot&& rhs) = default;
+
+        std::uint64_t count() const {
+            return _count;
+        }
+
+        std::chrono::microseconds mean() const {
+            if (_count == 0) { return std::chrono::microseconds(0); }
+            return std::chrono::microseconds(_total.count() / static_cast<std::int64_t>(_count));
+        }
+
+        std::chrono::microseconds max() const {
+            return _max;
+        }
+
+        // Upper bound of the bucket holding given percentile (0..100), so it overestimates by less than 1/16 of the value
+        std::chrono::microseconds percentile(double percentile) const;
+
+      private:
+        std::vector<std::uint64_t> _buckets;
+        std::uint64_t _count = 0;
+        std::chrono::microseconds _total {0};
+        std::chrono::microseconds _max {0};
+    };
+
+    // Log-linear histogram of latencies with microsecond resolution. Like in HdrHistogram, every power of two range is split
+    // into SUB_BUCKETS equal buckets, so relative error is bounded by bucket width for the whole 64-bit range.
+    // Recording takes a few relaxed atomic operations without locks or allocation, so it can be done on every message
+    class LatencyHistogram {
+      public:
+        static constexpr std::size_t SUB_BUCKET_BITS = 4;
+        static constexpr std::size_t SUB_BUCKETS     = std::size_t(1) << SUB_BUCKET_BITS;
+        static constexpr std::size_t BUCKETS         = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        LatencyHistogram() = default;
+        LatencyHistogram(const LatencyHistogram& rhs) = delete;
+
+        LatencyHistogram& operator=(const LatencyHistogram& rhs) = delete;
+
+        // Negative latencies (i.e. caused by clock skew between hosts) are recorded as zero
+        void record(std::chrono::microseconds latency);
+        LatencySnapshot snapshot() const;
+
+        static std::size_t bucket_index(std::uint64_t value);
+        // Highest value which falls into bucket with given index
+        static std::uint64_t bucket_upper_bound(std::size_t index);
+
+      private:
+        std::array<std::atomic<std::uint64_t>, BUCKETS> _buckets {};
+        std::atomic<std::uint64_t> _total {0};
+        std::atomic<std::uint64_t> _max {0};
+    };
+} // namespace assfire::messenger
\ No newline at end of file
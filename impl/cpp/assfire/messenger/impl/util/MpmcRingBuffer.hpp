@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace assfire::messenger {
+    // Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's design). Every cell carries a sequence number
+    // telling whether it is free for producer of given position or filled for consumer of it, so producers and consumers
+    // only contend on their own position counter. Positions grow monotonically and are reported to callers as message offsets
+    template <typename T>
+    class MpmcRingBuffer {
+      public:
+        // Capacity is rounded up to a power of two
+        explicit MpmcRingBuffer(std::size_t capacity)
+            : _capacity(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+              _mask(_capacity - 1),
+              _cells(std::make_unique<Cell[]>(_capacity)) {
+            for (std::size_t i = 0; i < _capacity; ++i) {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        MpmcRingBuffer(const MpmcRingBuffer& rhs) = delete;
+
+        MpmcRingBuffer& operator=(const MpmcRingBuffer& rhs) = delete;
+
+        // Returns false if the queue is full
+        template <typename U>
+        bool try_push(U&& value, std::uint64_t& position) {
+            std::uint64_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell                  = &_cells[pos & _mask];
+                std::uint64_t seq     = cell->sequence.load(std::memory_order_acquire);
+                std::int64_t distance = static_cast<std::int64_t>(seq - pos);
+                if (distance == 0) {
+                    if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+                } else if (distance < 0) {
+                    return false;
+                } else {
+                    pos = _enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = std::forward<U>(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            position = pos;
+            return true;
+        }
+
+        // Returns false if the queue is empty
+        bool try_pop(T& value, std::uint64_t& position) {
+            std::uint64_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell                  = &_cells[pos & _mask];
+                std::uint64_t seq     = cell->sequence.load(std::memory_order_acquire);
+                std::int64_t distance = static_cast<std::int64_t>(seq - (pos + 1));
+                if (distance == 0) {
+                    if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+                } else if (distance < 0) {
+                    return false;
+                } else {
+                    pos = _dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            value = std::move(cell->value);
+            cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+            position = pos;
+            return true;
+        }
+
+        // True if the next value to pop isn't published yet
+        bool empty() const {
+            std::uint64_t pos = _dequeue_pos.load(std::memory_order_acquire);
+            std::uint64_t seq = _cells[pos & _mask].sequence.load(std::memory_order_acquire);
+            return static_cast<std::int64_t>(seq - (pos + 1)) < 0;
+        }
+
+        // Approximate while producers or consumers are active
+        std::size_t size() const {
+            std::uint64_t dequeue_pos = _dequeue_pos.load(std::memory_order_acquire);
+            std::uint64_t enqueue_pos = _enqueue_pos.load(std::memory_order_acquire);
+            return enqueue_pos > dequeue_pos ? static_cast<std::size_t>(enqueue_pos - dequeue_pos) : 0;
+        }
+
+        std::size_t capacity() const {
+            return _capacity;
+        }
+
+      private:
+        struct alignas(64) Cell {
+            std::atomic<std::uint64_t> sequence;
+            T value;
+        };
+
+        std::size_t _capacity;
+        std::size_t _mask;
+        std::unique_ptr<Cell[]> _cells;
+        alignas(64) std::atomic<std::uint64_t> _enqueue_pos {0};
+        alignas(64) std::atomic<std::uint64_t> _dequeue_pos {0};
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace assfire::messenger {
+    // Marks current thread as doing given kind of work for given owner while in scope. Lets owner detect calls made from its
+    // own threads, i.e. consumer stopped from inside a handler must not wait for that handler to finish
+    class ScopedThreadRole {
+      public:
+        ScopedThreadRole(const void* owner, int role) : _previous_owner(_owner), _previous_role(_role) {
+            _owner = owner;
+            _role  = role;
+        }
+        ScopedThreadRole(const ScopedThreadRole& rhs) = delete;
+        ~ScopedThreadRole() {
+            _owner = _previous_owner;
+            _role  = _previous_role;
+        }
+
+        ScopedThreadRole& operator=(const ScopedThreadRole& rhs) = delete;
+
+        static bool current(const void* owner, int role) {
+            return _owner == owner && _role == role;
+        }
+
+      private:
+        static inline thread_local const void* _owner = nullptr;
+        static inline thread_local int _role          = 0;
+
+        const void* _previous_owner;
+        int _previous_role;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
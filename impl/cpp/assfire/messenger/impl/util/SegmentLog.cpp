@@ -0,0 +1,385 @@
+#include "SegmentLog.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace assfire::messenger {
+
+    namespace {
+        constexpr std::uint64_t MAGIC             = 0x4153534653504f4c;
+        constexpr std::size_t SEGMENT_HEADER_SIZE = 64;
+        constexpr std::size_t FRAME_HEADER_SIZE   = 2 * sizeof(std::uint32_t);
+        constexpr std::size_t FRAME_ALIGNMENT     = 8;
+        constexpr std::string_view SEGMENT_SUFFIX = ".log";
+
+        struct SegmentHeader {
+            std::uint64_t magic;
+            std::uint64_t id;
+            // Offset following the last committed record, zero until the first commit
+            std::uint64_t committed_offset;
+        };
+
+        static_assert(sizeof(SegmentHeader) <= SEGMENT_HEADER_SIZE);
+
+        constexpr std::array<std::uint32_t, 256> make_crc32c_table() {
+            std::array<std::uint32_t, 256> table {};
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78 : crc >> 1;
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        constexpr std::array<std::uint32_t, 256> CRC32C_TABLE = make_crc32c_table();
+
+        std::uint32_t crc32c(std::uint32_t crc, std::span<const std::uint8_t> data) {
+            crc = ~crc;
+            for (std::uint8_t byte : data) {
+                crc = CRC32C_TABLE[(crc ^ byte) & 0xff] ^ (crc >> 8);
+            }
+            return ~crc;
+        }
+
+        // Size is covered by checksum too, so zero-filled space never looks like a valid empty record
+        std::uint32_t frame_crc(std::uint32_t size, const std::uint8_t* data) {
+            std::uint32_t crc = crc32c(0, std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(&size), sizeof(size)));
+            return crc32c(crc, std::span<const std::uint8_t>(data, size));
+        }
+
+        constexpr std::size_t frame_size(std::size_t record_size) {
+            return (FRAME_HEADER_SIZE + record_size + FRAME_ALIGNMENT - 1) / FRAME_ALIGNMENT * FRAME_ALIGNMENT;
+        }
+
+        [[noreturn]] void throw_errno(const std::string& what, const std::string& path) {
+            throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+        }
+
+        std::string segment_file_name(std::uint64_t id) {
+            std::string digits = std::to_string(id);
+            return std::string(20 - std::min<std::size_t>(digits.size(), 20), '0') + digits + std::string(SEGMENT_SUFFIX);
+        }
+
+        std::optional<std::uint64_t> parse_segment_id(const std::string& file_name) {
+            if (!file_name.ends_with(SEGMENT_SUFFIX)) { return std::nullopt; }
+            std::uint64_t id = 0;
+            const char* end  = file_name.data() + file_name.size() - SEGMENT_SUFFIX.size();
+            auto result      = std::from_chars(file_name.data(), end, id);
+            if (result.ec != std::errc() || result.ptr != end) { return std::nullopt; }
+            return id;
+        }
+
+        SegmentHeader& header_of(std::uint8_t* data) {
+            return *reinterpret_cast<SegmentHeader*>(data);
+        }
+    } // namespace
+
+    struct SegmentLog::Segment {
+        std::uint64_t id;
+        std::string path;
+        std::uint8_t* data;
+        std::size_t size;
+        // End of valid records and end of records which are known to be on disk
+        std::size_t written;
+        std::size_t flushed;
+
+        ~Segment() {
+            munmap(data, size);
+        }
+    };
+
+    struct SegmentLog::FlushRange {
+        std::shared_ptr<Segment> segment;
+        std::size_t from;
+        std::size_t to;
+    };
+
+    SegmentLog::SegmentLog(std::string directory, std::size_t segment_size, std::size_t max_segments)
+        : _directory(std::move(directory)),
+          _segment_size(segment_size),
+          _max_segments(std::max<std::size_t>(max_segments, 1)) {
+        if (_segment_size < SEGMENT_HEADER_SIZE + frame_size(1)) {
+            throw std::runtime_error("Segment size " + std::to_string(_segment_size) + " is too small");
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(_directory, ec);
+        if (ec) { throw std::runtime_error("Failed to create segment log directory " + _directory + ": " + ec.message()); }
+
+        std::vector<std::uint64_t> ids;
+        for (const auto& entry : std::filesystem::directory_iterator(_directory)) {
+            if (auto id = parse_segment_id(entry.path().filename().string())) { ids.push_back(*id); }
+        }
+        std::sort(ids.begin(), ids.end());
+        for (std::uint64_t id : ids) {
+            _segments.push_back(open_segment(id, false));
+        }
+
+        if (!_segments.empty()) {
+            const Segment& head = *_segments.front();
+            _commit_segment_id  = head.id;
+            _commit_offset      = std::clamp<std::size_t>(header_of(head.data).committed_offset, SEGMENT_HEADER_SIZE, head.written);
+            _read_segment_id    = _commit_segment_id;
+            _read_offset        = _commit_offset;
+            remove_committed_segments();
+        } else {
+            _commit_offset = SEGMENT_HEADER_SIZE;
+            _read_offset   = SEGMENT_HEADER_SIZE;
+        }
+    }
+
+    SegmentLog::~SegmentLog() {
+        for (const auto& segment : _segments) {
+            msync(segment->data, segment->written, MS_SYNC);
+        }
+    }
+
+    void SegmentLog::append(std::span<const std::uint8_t> data) {
+        if (data.size() > max_record_size()) {
+            throw std::runtime_error("Record of " + std::to_string(data.size()) + " bytes doesn't fit into segments of log " + _directory);
+        }
+
+        std::unique_lock<std::mutex> lck(_mtx);
+        write(data);
+        flush(lck, ++_appended_count);
+    }
+
+    std::size_t SegmentLog::append_batch(std::span<const std::vector<std::uint8_t>> records) {
+        std::unique_lock<std::mutex> lck(_mtx);
+        std::size_t appended = 0;
+        for (const std::vector<std::uint8_t>& data : records) {
+            if (!fits(data.size())) { break; }
+            write(data);
+            ++_appended_count;
+            ++appended;
+        }
+        if (appended > 0) { flush(lck, _appended_count); }
+        return appended;
+    }
+
+    std::optional<SegmentLog::Record> SegmentLog::read() {
+        std::lock_guard<std::mutex> lck(_mtx);
+        for (std::size_t i = 0; i < _segments.size(); ++i) {
+            const Segment& segment = *_segments[i];
+            if (segment.id < _read_segment_id) { continue; }
+            if (segment.id > _read_segment_id) {
+                _read_segment_id = segment.id;
+                _read_offset     = SEGMENT_HEADER_SIZE;
+            }
+            if (_read_offset < segment.written) {
+                std::uint32_t size = 0;
+                std::memcpy(&size, segment.data + _read_offset, sizeof(size));
+                std::size_t offset = _read_offset;
+                _read_offset += frame_size(size);
+                return Record(segment.id, offset, _read_offset, std::span<const std::uint8_t>(segment.data + offset + FRAME_HEADER_SIZE, size));
+            }
+        }
+        return std::nullopt;
+    }
+
+    void SegmentLog::commit(const Record& record) {
+        std::lock_guard<std::mutex> lck(_mtx);
+        Segment* segment = find_segment(record._segment_id);
+        if (!segment) { return; }
+        _commit_segment_id                        = record._segment_id;
+        _commit_offset                            = record._end;
+        header_of(segment->data).committed_offset = _commit_offset;
+        _commit_dirty                             = true;
+        remove_committed_segments();
+    }
+
+    void SegmentLog::rewind() {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _read_segment_id = _commit_segment_id;
+        _read_offset     = _commit_offset;
+    }
+
+    bool SegmentLog::empty() const {
+        std::lock_guard<std::mutex> lck(_mtx);
+        return std::none_of(_segments.begin(), _segments.end(), [&](const auto& segment) {
+            if (segment->id < _commit_segment_id) { return false; }
+            return segment->written > (segment->id == _commit_segment_id ? _commit_offset : SEGMENT_HEADER_SIZE);
+        });
+    }
+
+    std::size_t SegmentLog::segments_count() const {
+        std::lock_guard<std::mutex> lck(_mtx);
+        return _segments.size();
+    }
+
+    std::size_t SegmentLog::max_record_size() const {
+        return std::min<std::size_t>(_segment_size - SEGMENT_HEADER_SIZE - FRAME_HEADER_SIZE - FRAME_ALIGNMENT, UINT32_MAX);
+    }
+
+    std::shared_ptr<SegmentLog::Segment> SegmentLog::open_segment(std::uint64_t id, bool create) {
+        std::string path = (std::filesystem::path(_directory) / segment_file_name(id)).string();
+
+        int fd = create ? open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644) : open(path.c_str(), O_RDWR);
+        if (fd < 0) { throw_errno("Failed to open log segment", path); }
+        if (create && ftruncate(fd, static_cast<off_t>(_segment_size)) != 0) {
+            close(fd);
+            unlink(path.c_str());
+            throw_errno("Failed to size log segment", path);
+        }
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) != _segment_size) {
+            close(fd);
+            throw std::runtime_error("Log segment " + path + " has unexpected size");
+        }
+
+        void* mapping = mmap(nullptr, _segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) { throw_errno("Failed to map log segment", path); }
+
+        auto segment     = std::make_shared<Segment>();
+        segment->id      = id;
+        segment->path    = std::move(path);
+        segment->data    = static_cast<std::uint8_t*>(mapping);
+        segment->size    = _segment_size;
+        SegmentHeader& h = header_of(segment->data);
+
+        if (create) {
+            h.magic          = MAGIC;
+            h.id             = id;
+            segment->written = SEGMENT_HEADER_SIZE;
+            segment->flushed = 0;
+            // Directory entry of the new file must reach the disk too, otherwise records flushed into it may be lost
+            int dir_fd = open(_directory.c_str(), O_RDONLY | O_DIRECTORY);
+            if (dir_fd >= 0) {
+                fsync(dir_fd);
+                close(dir_fd);
+            }
+            return segment;
+        }
+
+        if (h.magic != MAGIC || h.id != id) { throw std::runtime_error("Log segment " + segment->path + " is corrupted"); }
+
+        // Records are scanned until zero-filled space or the first record torn by a crash, which is wiped with everything after it
+        std::size_t offset = SEGMENT_HEADER_SIZE;
+        while (offset + FRAME_HEADER_SIZE <= _segment_size) {
+            std::uint32_t size = 0;
+            std::uint32_t crc  = 0;
+            std::memcpy(&size, segment->data + offset, sizeof(size));
+            std::memcpy(&crc, segment->data + offset + sizeof(size), sizeof(crc));
+            if (size == 0 && crc == 0) { break; }
+            if (size > _segment_size - offset - FRAME_HEADER_SIZE || frame_crc(size, segment->data + offset + FRAME_HEADER_SIZE) != crc) {
+                std::memset(segment->data + offset, 0, _segment_size - offset);
+                break;
+            }
+            offset += frame_size(size);
+        }
+        segment->written = std::min(offset, _segment_size);
+        segment->flushed = segment->written;
+        return segment;
+    }
+
+    SegmentLog::Segment& SegmentLog::writable_segment(std::size_t record_size) {
+        if (!_segments.empty() && _segments.back()->written + frame_size(record_size) <= _segment_size) { return *_segments.back(); }
+        if (_segments.size() >= _max_segments) { throw std::runtime_error("Segment log " + _directory + " is full"); }
+
+        std::uint64_t id = _segments.empty() ? _commit_segment_id : _segments.back()->id + 1;
+        _segments.push_back(open_segment(id, true));
+        remove_committed_segments();
+        return *_segments.back();
+    }
+
+    bool SegmentLog::fits(std::size_t record_size) const {
+        if (record_size > max_record_size()) { return false; }
+        return (!_segments.empty() && _segments.back()->written + frame_size(record_size) <= _segment_size) || _segments.size() < _max_segments;
+    }
+
+    // Record becomes visible to reader right away, but appender returns only after it is flushed
+    void SegmentLog::write(std::span<const std::uint8_t> data) {
+        Segment& segment    = writable_segment(data.size());
+        std::uint8_t* frame = segment.data + segment.written;
+
+        std::uint32_t size = static_cast<std::uint32_t>(data.size());
+        std::uint32_t crc  = frame_crc(size, data.data());
+        std::memcpy(frame + sizeof(std::uint32_t), &crc, sizeof(crc));
+        std::memcpy(frame + FRAME_HEADER_SIZE, data.data(), data.size());
+        std::memcpy(frame, &size, sizeof(size));
+        segment.written += frame_size(data.size());
+    }
+
+    SegmentLog::Segment* SegmentLog::find_segment(std::uint64_t id) const {
+        for (const auto& segment : _segments) {
+            if (segment->id == id) { return segment.get(); }
+        }
+        return nullptr;
+    }
+
+    void SegmentLog::flush(std::unique_lock<std::mutex>& lck, std::uint64_t appended) {
+        while (_flushed_count < appended) {
+            if (_flushing) {
+                _flushed_cv.wait(lck);
+                continue;
+            }
+
+            _flushing            = true;
+            std::uint64_t target = _appended_count;
+            std::vector<FlushRange> ranges;
+            for (const auto& segment : _segments) {
+                if (segment->written > segment->flushed) { ranges.push_back(FlushRange {segment, segment->flushed, segment->written}); }
+            }
+            if (_commit_dirty && !_segments.empty()) {
+                ranges.push_back(FlushRange {_segments.front(), 0, SEGMENT_HEADER_SIZE});
+                _commit_dirty = false;
+            }
+            lck.unlock();
+
+            static const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            int error                          = 0;
+            for (const FlushRange& range : ranges) {
+                std::size_t from = range.from / page_size * page_size;
+                if (msync(range.segment->data + from, range.to - from, MS_SYNC) != 0) { error = errno; }
+            }
+
+            lck.lock();
+            _flushing = false;
+            if (error == 0) {
+                for (const FlushRange& range : ranges) {
+                    range.segment->flushed = std::max(range.segment->flushed, range.to);
+                }
+                _flushed_count = std::max(_flushed_count, target);
+            }
+            _flushed_cv.notify_all();
+            if (error != 0) {
+                errno = error;
+                throw_errno("Failed to flush segments of log", _directory);
+            }
+        }
+    }
+
+    void SegmentLog::remove_committed_segments() {
+        while (_segments.size() > 1) {
+            const Segment& head = *_segments.front();
+            bool committed      = head.id < _commit_segment_id || (head.id == _commit_segment_id && _commit_offset >= head.written);
+            if (!committed) { return; }
+
+            unlink(head.path.c_str());
+            _segments.pop_front();
+            const Segment& next = *_segments.front();
+            if (_commit_segment_id < next.id) {
+                _commit_segment_id = next.id;
+                _commit_offset     = SEGMENT_HEADER_SIZE;
+            }
+            if (_read_segment_id < next.id) {
+                _read_segment_id = next.id;
+                _read_offset     = SEGMENT_HEADER_SIZE;
+            }
+        }
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace assfire::messenger {
+    // Append-only log of records kept in fixed-size memory-mapped segment files of a directory.
+    // Every record carries its CRC32C, so records torn by a crash are detected and dropped when the log is reopened.
+    // Append returns only after the record is flushed to disk, but concurrent appends are flushed together by one msync (group commit).
+    // Records are read in append order by a single reader, which commits them once they are processed. Segments holding only committed
+    // records are removed. Committed position is persisted lazily, so records committed shortly before a crash may be read again
+    class SegmentLog {
+      public:
+        class Record {
+          public:
+            Record(std::uint64_t segment_id, std::size_t offset, std::size_t end, std::span<const std::uint8_t> data)
+                : _segment_id(segment_id),
+                  _offset(offset),
+                  _end(end),
+                  _data(data) {}
+
+            // Stays valid until the record is committed
+            std::span<const std::uint8_t> data() const {
+                return _data;
+            }
+
+          private:
+            friend class SegmentLog;
+
+            std::uint64_t _segment_id;
+            std::size_t _offset;
+            std::size_t _end;
+            std::span<const std::uint8_t> _data;
+        };
+
+        // Reopens records left in directory, creating directory if it doesn't exist. Throws std::runtime_error if it can't be opened
+        SegmentLog(std::string directory, std::size_t segment_size, std::size_t max_segments);
+        ~SegmentLog();
+        SegmentLog(const SegmentLog& rhs) = delete;
+
+        SegmentLog& operator=(const SegmentLog& rhs) = delete;
+
+        // Throws std::runtime_error if record can't fit into a segment, all segments are full or writing to disk fails
+        void append(std::span<const std::uint8_t> data);
+
+        // Appends records in order and flushes them together. Stops at the first record which doesn't fit into a segment
+        // or when all segments are full, returning count of appended records. Throws std::runtime_error if writing to disk fails
+        std::size_t append_batch(std::span<const std::vector<std::uint8_t>> records);
+
+        // Returns record following the last read one, or nothing if all appended records were read
+        std::optional<Record> read();
+
+        // Commits given record and all records read before it
+        void commit(const Record& record);
+
+        // Makes next read return the first record which wasn't committed
+        void rewind();
+
+        // True if there are no uncommitted records
+        bool empty() const;
+
+        std::size_t segments_count() const;
+
+        // Largest record which fits into a segment
+        std::size_t max_record_size() const;
+
+      private:
+        struct Segment;
+        struct FlushRange;
+
+        std::shared_ptr<Segment> open_segment(std::uint64_t id, bool create);
+        Segment& writable_segment(std::size_t record_size);
+        bool fits(std::size_t record_size) const;
+        void write(std::span<const std::uint8_t> data);
+        Segment* find_segment(std::uint64_t id) const;
+        void flush(std::unique_lock<std::mutex>& lck, std::uint64_t appended);
+        void remove_committed_segments();
+
+        std::string _directory;
+        std::size_t _segment_size;
+        std::size_t _max_segments;
+        mutable std::mutex _mtx;
+        std::deque<std::shared_ptr<Segment>> _segments;
+        std::uint64_t _read_segment_id   = 0;
+        std::size_t _read_offset         = 0;
+        std::uint64_t _commit_segment_id = 0;
+        std::size_t _commit_offset       = 0;
+        bool _commit_dirty               = false;
+        // Appenders wait until flushed count reaches their record, one of them flushing all appended records while others wait
+        std::uint64_t _appended_count = 0;
+        std::uint64_t _flushed_count  = 0;
+        bool _flushing                = false;
+        std::condition_variable _flushed_cv;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace assfire::messenger {
+    // Bounded lock-free queue for exactly one producer thread and one consumer thread at a time. Each side keeps a cached copy
+    // of the other side's index and rereads it only when the queue looks full or empty, so in steady state push and pop touch
+    // no cache line written by the other side except the slot itself
+    template <typename T>
+    class SpscRingBuffer {
+      public:
+        // Capacity is rounded up to a power of two
+        explicit SpscRingBuffer(std::size_t capacity)
+            : _capacity(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+              _mask(_capacity - 1),
+              _slots(std::make_unique<T[]>(_capacity)) {}
+        SpscRingBuffer(const SpscRingBuffer& rhs) = delete;
+
+        SpscRingBuffer& operator=(const SpscRingBuffer& rhs) = delete;
+
+        // Returns false if the queue is full. Must only be called by producer thread
+        template <typename U>
+        bool try_push(U&& value, std::uint64_t& position) {
+            std::uint64_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cached_head >= _capacity) {
+                _cached_head = _head.load(std::memory_order_acquire);
+                if (tail - _cached_head >= _capacity) { return false; }
+            }
+            _slots[tail & _mask] = std::forward<U>(value);
+            _tail.store(tail + 1, std::memory_order_release);
+            position = tail;
+            return true;
+        }
+
+        // Returns false if the queue is empty. Must only be called by consumer thread
+        bool try_pop(T& value, std::uint64_t& position) {
+            std::uint64_t head = _head.load(std::memory_order_relaxed);
+            if (head == _cached_tail) {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                if (head == _cached_tail) { return false; }
+            }
+            value = std::move(_slots[head & _mask]);
+            _head.store(head + 1, std::memory_order_release);
+            position = head;
+            return true;
+        }
+
+        bool empty() const {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+        // Approximate while producer or consumer is active
+        std::size_t size() const {
+            std::uint64_t head = _head.load(std::memory_order_acquire);
+            std::uint64_t tail = _tail.load(std::memory_order_acquire);
+            return tail > head ? static_cast<std::size_t>(tail - head) : 0;
+        }
+
+        std::size_t capacity() const {
+            return _capacity;
+        }
+
+      private:
+        std::size_t _capacity;
+        std::size_t _mask;
+        std::unique_ptr<T[]> _slots;
+        alignas(64) std::atomic<std::uint64_t> _tail {0};
+        std::uint64_t _cached_head = 0;
+        alignas(64) std::atomic<std::uint64_t> _head {0};
+        std::uint64_t _cached_tail = 0;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
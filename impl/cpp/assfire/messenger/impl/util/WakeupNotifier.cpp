@@ -0,0 +1,66 @@
+#include "WakeupNotifier.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace assfire::messenger {
+
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) && std::atomic<std::uint32_t>::is_always_lock_free,
+                  "Futex word must be a plain 32-bit integer");
+
+    namespace {
+        std::size_t default_spin_iterations() {
+            return std::thread::hardware_concurrency() > 1 ? WakeupNotifier::DEFAULT_SPIN_ITERATIONS : 0;
+        }
+    } // namespace
+
+    WakeupNotifier::WakeupNotifier() : WakeupNotifier(default_spin_iterations()) {}
+
+    WakeupNotifier::WakeupNotifier(std::atomic<std::uint32_t>& epoch, std::atomic<std::uint32_t>& waiters)
+        : _epoch(&epoch),
+          _waiters(&waiters),
+          _spin_iterations(default_spin_iterations()),
+          _process_shared(true) {}
+
+    void WakeupNotifier::notify(std::size_t count) {
+        if (count == 0) { return; }
+        _epoch->fetch_add(1);
+        std::uint32_t waiters = _waiters->load();
+        if (waiters > 0) { wake(std::min<std::size_t>(count, waiters)); }
+    }
+
+    void WakeupNotifier::notify_all() {
+        _epoch->fetch_add(1);
+        if (_waiters->load() > 0) { wake(INT_MAX); }
+    }
+
+    // Spurious wakeups, timeouts and epoch mismatches are all handled by rechecking in wait_for
+    void WakeupNotifier::park(std::uint32_t epoch, std::chrono::nanoseconds timeout) {
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        timespec ts {};
+        ts.tv_sec  = seconds.count();
+        ts.tv_nsec = (timeout - seconds).count();
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(_epoch), _process_shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, epoch, &ts, nullptr, 0);
+    }
+
+    void WakeupNotifier::wake(std::size_t count) {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(_epoch), _process_shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE,
+                static_cast<int>(std::min<std::size_t>(count, INT_MAX)), nullptr, nullptr, 0);
+    }
+
+    void WakeupNotifier::cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+
+} // namespace assfire::messenger
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace assfire::messenger {
+    // Wakes threads waiting for some condition (i.e. non-empty queue) with lower handoff latency than mutex and condition variable.
+    // Waiter first spins checking the condition for a bounded number of iterations and only then parks on a futex.
+    // Notifier bumps an epoch word and issues futex wake only when there are parked waiters, waking no more of them than requested.
+    // Epoch and waiters words may be placed in memory shared between processes, then waiters and notifiers may live in different processes
+    class WakeupNotifier {
+      public:
+        static constexpr std::size_t DEFAULT_SPIN_ITERATIONS = 4000;
+
+        // Spinning only delays the notifying thread on a single CPU, so it is disabled there by default
+        WakeupNotifier();
+        explicit WakeupNotifier(std::size_t spin_iterations)
+            : _epoch(&_own_epoch),
+              _waiters(&_own_waiters),
+              _spin_iterations(spin_iterations),
+              _process_shared(false) {}
+        // Works over external words which must outlive the notifier, i.e. ones placed in shared memory mapping
+        WakeupNotifier(std::atomic<std::uint32_t>& epoch, std::atomic<std::uint32_t>& waiters);
+        WakeupNotifier(const WakeupNotifier& rhs) = delete;
+
+        WakeupNotifier& operator=(const WakeupNotifier& rhs) = delete;
+
+        // Returns false if condition isn't satisfied when timeout expires
+        template <typename Predicate>
+        bool wait_for(Predicate ready, std::chrono::milliseconds timeout) {
+            for (std::size_t i = 0; i < _spin_iterations; ++i) {
+                if (ready()) { return true; }
+                cpu_relax();
+            }
+
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (true) {
+                // Epoch is read before checking condition, so notification that happens after the check makes park return immediately
+                std::uint32_t epoch = _epoch->load(std::memory_order_acquire);
+                if (ready()) { return true; }
+
+                auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) { return false; }
+
+                _waiters->fetch_add(1);
+                park(epoch, std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now));
+                _waiters->fetch_sub(1);
+            }
+        }
+
+        // Wakes up to count parked waiters. Must be called after the condition is made true
+        void notify(std::size_t count);
+        void notify_all();
+
+        // Changes on every notification, so waiting for its change waits for the next notification
+        std::uint32_t epoch() const {
+            return _epoch->load(std::memory_order_acquire);
+        }
+
+      private:
+        void park(std::uint32_t epoch, std::chrono::nanoseconds timeout);
+        void wake(std::size_t count);
+        static void cpu_relax();
+
+        std::atomic<std::uint32_t> _own_epoch {0};
+        std::atomic<std::uint32_t> _own_waiters {0};
+        std::atomic<std::uint32_t>* _epoch;
+        std::atomic<std::uint32_t>* _waiters;
+        std::size_t _spin_iterations;
+        bool _process_shared;
+    };
+} // namespace assfire::messenger
\ No newline at end of file
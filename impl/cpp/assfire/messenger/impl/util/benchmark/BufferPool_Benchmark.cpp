@@ -0,0 +1,52 @@
+#include "assfire/messenger/impl/util/BufferPool.hpp"
+#include "assfire/messenger/impl/util/SpscRingBuffer.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <thread>
+
+using namespace assfire::messenger;
+
+namespace {
+    // Roughly the size of a received record
+    using Record = std::array<char, 96>;
+
+    // Records are allocated on one thread and released on another, as by consume loop and the thread polling messages
+    void hand_off(benchmark::State& state, const std::function<std::shared_ptr<Record>()>& allocate) {
+        constexpr std::size_t batch_size = 1000;
+        SpscRingBuffer<std::shared_ptr<Record>> ring(1024);
+        for (auto _ : state) {
+            std::thread releaser([&] {
+                std::shared_ptr<Record> record;
+                std::uint64_t position;
+                for (std::size_t released = 0; released < batch_size;) {
+                    if (ring.try_pop(record, position)) {
+                        record.reset();
+                        ++released;
+                    }
+                }
+            });
+            std::uint64_t position;
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                auto record = allocate();
+                while (!ring.try_push(std::move(record), position)) {}
+            }
+            releaser.join();
+        }
+        state.SetItemsProcessed(state.iterations() * batch_size);
+    }
+} // namespace
+
+static void BufferPool_AllocateSharedHandOff(benchmark::State& state) {
+    auto pool = BufferPool::create(4096);
+    hand_off(state, [&] { return std::allocate_shared<Record>(PoolAllocator<Record>(pool.get())); });
+}
+
+BENCHMARK(BufferPool_AllocateSharedHandOff)->UseRealTime();
+
+static void BufferPool_MakeSharedHandOff(benchmark::State& state) {
+    hand_off(state, [] { return std::make_shared<Record>(); });
+}
+
+BENCHMARK(BufferPool_MakeSharedHandOff)->UseRealTime();
\ No newline at end of file
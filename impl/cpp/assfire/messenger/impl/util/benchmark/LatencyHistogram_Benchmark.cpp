@@ -0,0 +1,30 @@
+#include "assfire/messenger/impl/util/LatencyHistogram.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace assfire::messenger;
+
+static void LatencyHistogram_Record(benchmark::State& state) {
+    static LatencyHistogram histogram;
+    std::int64_t latency = state.thread_index() * 7919;
+    for (auto _ : state) {
+        histogram.record(std::chrono::microseconds(latency));
+        latency = (latency + 104729) % 10000000;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(LatencyHistogram_Record)->Threads(1)->Threads(4);
+
+static void LatencyHistogram_Snapshot(benchmark::State& state) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 100000; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    for (auto _ : state) {
+        LatencySnapshot snapshot = histogram.snapshot();
+        benchmark::DoNotOptimize(snapshot.percentile(99));
+    }
+}
+
+BENCHMARK(LatencyHistogram_Snapshot);
\ No newline at end of file
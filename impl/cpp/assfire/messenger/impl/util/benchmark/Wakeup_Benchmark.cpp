@@ -0,0 +1,94 @@
+#include "assfire/messenger/impl/util/WakeupNotifier.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Handoff used by KafkaConsumer before wakeup notifier was introduced, kept as a baseline
+    class ConditionVariableWakeup {
+      public:
+        template <typename Predicate>
+        bool wait_for(Predicate ready, std::chrono::milliseconds timeout) {
+            std::unique_lock<std::mutex> lck(_mtx);
+            return _cv.wait_for(lck, timeout, ready);
+        }
+
+        void notify(std::size_t) {
+            _cv.notify_all();
+        }
+
+      private:
+        std::mutex _mtx;
+        std::condition_variable _cv;
+    };
+
+    // Measures time from publishing a value to the moment a waiting thread observes it. Publisher waits for each handoff
+    // to complete and then stays idle for state.range(0) microseconds, so that long gaps make the waiter park.
+    // Iteration time includes the idle gap, percentiles of handoff latency are reported as counters
+    template <typename Wakeup>
+    void run_handoff(benchmark::State& state, Wakeup& wakeup) {
+        std::atomic<std::uint64_t> published {0};
+        std::atomic<std::uint64_t> observed {0};
+        std::atomic<Clock::rep> published_at {0};
+        std::atomic_bool interrupted {false};
+        std::vector<std::int64_t> latencies;
+
+        std::thread waiter([&] {
+            std::uint64_t expected = 1;
+            while (!interrupted) {
+                if (!wakeup.wait_for([&] { return published.load() >= expected || interrupted.load(); }, 100ms)) { continue; }
+                if (interrupted) { break; }
+                latencies.push_back((Clock::now().time_since_epoch().count() - published_at.load()));
+                observed.store(expected++);
+            }
+        });
+
+        std::chrono::microseconds idle_gap(state.range(0));
+        std::uint64_t sequence = 0;
+        for (auto _ : state) {
+            if (idle_gap.count() > 0) { std::this_thread::sleep_for(idle_gap); }
+
+            published_at.store(Clock::now().time_since_epoch().count());
+            published.store(++sequence);
+            wakeup.notify(1);
+            while (observed.load() != sequence) {
+                std::this_thread::yield();
+            }
+        }
+
+        interrupted = true;
+        wakeup.notify(1);
+        waiter.join();
+
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) {
+            if (latencies.empty()) { return 0.0; }
+            std::size_t index = std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()));
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::duration(latencies[index])).count());
+        };
+        state.counters["p50_ns"] = percentile(0.50);
+        state.counters["p99_ns"] = percentile(0.99);
+    }
+} // namespace
+
+static void Wakeup_ConditionVariableHandoff(benchmark::State& state) {
+    ConditionVariableWakeup wakeup;
+    run_handoff(state, wakeup);
+}
+BENCHMARK(Wakeup_ConditionVariableHandoff)->Arg(0)->Arg(500)->Iterations(20000)->UseRealTime();
+
+static void Wakeup_SpinThenParkHandoff(benchmark::State& state) {
+    WakeupNotifier wakeup;
+    run_handoff(state, wakeup);
+}
+BENCHMARK(Wakeup_SpinThenParkHandoff)->Arg(0)->Arg(500)->Iterations(20000)->UseRealTime();
\ No newline at end of file
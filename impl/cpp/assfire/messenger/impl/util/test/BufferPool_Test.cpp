@@ -0,0 +1,92 @@
+#include "assfire/messenger/impl/util/BufferPool.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace assfire::messenger;
+
+TEST(BufferPoolTest, ReleasedBlocksAreReusedWithinSizeClass) {
+    auto owner       = BufferPool::create(16);
+    BufferPool& pool = *owner;
+
+    void* block = pool.allocate(100);
+    EXPECT_EQ(pool.heap_allocations(), 1);
+    pool.deallocate(block, 100);
+    EXPECT_EQ(pool.cached_blocks(), 1);
+
+    EXPECT_EQ(pool.allocate(128), block);
+    EXPECT_EQ(pool.heap_allocations(), 1);
+    EXPECT_EQ(pool.cached_blocks(), 0);
+
+    void* smaller = pool.allocate(64);
+    EXPECT_NE(smaller, block);
+    EXPECT_EQ(pool.heap_allocations(), 2);
+
+    pool.deallocate(block, 128);
+    pool.deallocate(smaller, 64);
+}
+
+TEST(BufferPoolTest, OversizedBlocksAndBlocksOverflowingFreeListAreNotCached) {
+    auto owner       = BufferPool::create(2);
+    BufferPool& pool = *owner;
+
+    void* oversized = pool.allocate(BufferPool::max_block_size + 1);
+    pool.deallocate(oversized, BufferPool::max_block_size + 1);
+    EXPECT_EQ(pool.cached_blocks(), 0);
+    EXPECT_EQ(pool.heap_allocations(), 0);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 4; ++i) {
+        blocks.push_back(pool.allocate(32));
+    }
+    for (void* block : blocks) {
+        pool.deallocate(block, 32);
+    }
+    EXPECT_EQ(pool.cached_blocks(), 2);
+}
+
+TEST(BufferPoolTest, SharedObjectsAreAllocatedFromPoolInSteadyState) {
+    auto pool = BufferPool::create(16);
+
+    for (int i = 0; i < 1000; ++i) {
+        auto value = std::allocate_shared<std::string>(PoolAllocator<std::string>(pool.get()), "value");
+        EXPECT_EQ(*value, "value");
+    }
+    EXPECT_EQ(pool->heap_allocations(), 1);
+    EXPECT_EQ(pool->cached_blocks(), 1);
+}
+
+TEST(BufferPoolTest, ObjectsKeepPoolAliveAfterOwnerReleasesIt) {
+    auto pool = BufferPool::create(16);
+    std::vector<std::shared_ptr<std::string>> values;
+    for (int i = 0; i < 32; ++i) {
+        values.push_back(std::allocate_shared<std::string>(PoolAllocator<std::string>(pool.get()), std::to_string(i)));
+    }
+
+    pool.reset();
+    for (int i = 0; i < 32; ++i) {
+        EXPECT_EQ(*values[i], std::to_string(i));
+    }
+    values.clear();
+}
+
+TEST(BufferPoolTest, BlocksAreReleasedOnOtherThreads) {
+    auto pool = BufferPool::create(1024);
+    constexpr int count = 100000;
+
+    std::vector<std::shared_ptr<int>> values;
+    values.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        values.push_back(std::allocate_shared<int>(PoolAllocator<int>(pool.get()), i));
+    }
+    std::thread releaser([&] { values.clear(); });
+    releaser.join();
+
+    EXPECT_EQ(pool->cached_blocks(), 1024);
+    for (int i = 0; i < 1024; ++i) {
+        values.push_back(std::allocate_shared<int>(PoolAllocator<int>(pool.get()), i));
+    }
+    EXPECT_EQ(pool->heap_allocations(), count);
+}
\ No newline at end of file
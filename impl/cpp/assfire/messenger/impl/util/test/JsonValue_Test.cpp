@@ -0,0 +1,59 @@
+#include "assfire/messenger/impl/util/JsonValue.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace assfire::messenger;
+
+TEST(JsonValueTest, ObjectMembersAreFound) {
+    JsonValue json = JsonValue::parse(R"({"name": "rdkafka#producer-1", "msg_cnt": 42, "rtt": {"p99": 1500.5}, "brokers": {}})");
+
+    ASSERT_TRUE(json.is_object());
+    EXPECT_EQ(json.find("name")->as_string(), "rdkafka#producer-1");
+    EXPECT_EQ(json.find("msg_cnt")->as_int(), 42);
+    EXPECT_DOUBLE_EQ(json.find_path({"rtt", "p99"})->as_double(), 1500.5);
+    EXPECT_TRUE(json.find("brokers")->members().empty());
+    EXPECT_EQ(json.find("missing"), nullptr);
+    EXPECT_EQ(json.find_path({"rtt", "missing"}), nullptr);
+}
+
+TEST(JsonValueTest, LargeIntegersKeepPrecision) {
+    JsonValue json = JsonValue::parse("[9007199254740993, -1, 1e3, 2.5E-1]");
+
+    ASSERT_EQ(json.elements().size(), 4);
+    EXPECT_EQ(json.elements()[0].as_int(), 9007199254740993);
+    EXPECT_EQ(json.elements()[1].as_int(), -1);
+    EXPECT_DOUBLE_EQ(json.elements()[2].as_double(), 1000);
+    EXPECT_DOUBLE_EQ(json.elements()[3].as_double(), 0.25);
+}
+
+TEST(JsonValueTest, LiteralsAndEscapesAreParsed) {
+    JsonValue json = JsonValue::parse(R"({"a": true, "b": false, "c": null, "d": "line\nbreak \"quoted\" é"})");
+
+    EXPECT_TRUE(json.find("a")->as_bool());
+    EXPECT_FALSE(json.find("b")->as_bool(true));
+    EXPECT_TRUE(json.find("c")->is_null());
+    EXPECT_EQ(json.find("d")->as_string(), "line\nbreak \"quoted\" \xC3\xA9");
+}
+
+TEST(JsonValueTest, MismatchedTypesReturnFallback) {
+    JsonValue json = JsonValue::parse(R"({"a": "text"})");
+
+    EXPECT_EQ(json.find("a")->as_int(7), 7);
+    EXPECT_EQ(json.as_string("fallback"), "fallback");
+    EXPECT_TRUE(json.elements().empty());
+}
+
+TEST(JsonValueTest, InvalidDocumentIsRejected) {
+    EXPECT_THROW(JsonValue::parse(R"({"a": )"), std::invalid_argument);
+    EXPECT_THROW(JsonValue::parse(R"({"a": 1,})"), std::invalid_argument);
+    EXPECT_THROW(JsonValue::parse("[1, 2] 3"), std::invalid_argument);
+    EXPECT_THROW(JsonValue::parse("tru"), std::invalid_argument);
+    EXPECT_THROW(JsonValue::parse(""), std::invalid_argument);
+}
+
+TEST(JsonValueTest, DeeplyNestedDocumentIsRejected) {
+    EXPECT_NO_THROW(JsonValue::parse(std::string(64, '[') + std::string(64, ']')));
+    EXPECT_THROW(JsonValue::parse(std::string(65, '[') + std::string(65, ']')), std::invalid_argument);
+    EXPECT_THROW(JsonValue::parse(std::string(100000, '[')), std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "assfire/messenger/impl/util/LatencyHistogram.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, BucketsCoverWholeRangeContiguously) {
+    EXPECT_EQ(LatencyHistogram::bucket_index(0), 0);
+    EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+
+    for (std::size_t i = 1; i < LatencyHistogram::BUCKETS; ++i) {
+        std::uint64_t lower_bound = LatencyHistogram::bucket_upper_bound(i - 1) + 1;
+        ASSERT_EQ(LatencyHistogram::bucket_index(lower_bound), i);
+        ASSERT_EQ(LatencyHistogram::bucket_index(LatencyHistogram::bucket_upper_bound(i)), i);
+    }
+}
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZeros) {
+    LatencyHistogram histogram;
+    LatencySnapshot snapshot = histogram.snapshot();
+
+    EXPECT_EQ(snapshot.count(), 0);
+    EXPECT_EQ(snapshot.mean(), 0us);
+    EXPECT_EQ(snapshot.percentile(99), 0us);
+}
+
+TEST(LatencyHistogramTest, PercentilesAreWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 10000; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    LatencySnapshot snapshot = histogram.snapshot();
+
+    EXPECT_EQ(snapshot.count(), 10000);
+    EXPECT_EQ(snapshot.max(), 10000us);
+    EXPECT_EQ(snapshot.mean(), 5000us);
+    EXPECT_GE(snapshot.percentile(50), 5000us);
+    EXPECT_LE(snapshot.percentile(50), 5000us + 5000us / LatencyHistogram::SUB_BUCKETS);
+    EXPECT_GE(snapshot.percentile(99), 9900us);
+    EXPECT_LE(snapshot.percentile(99), 10000us);
+    EXPECT_EQ(snapshot.percentile(100), 10000us);
+}
+
+TEST(LatencyHistogramTest, NegativeLatencyIsRecordedAsZero) {
+    LatencyHistogram histogram;
+    histogram.record(-5ms);
+
+    EXPECT_EQ(histogram.snapshot().count(), 1);
+    EXPECT_EQ(histogram.snapshot().percentile(50), 0us);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordsAreNotLost) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram] {
+            for (int i = 0; i < 10000; ++i) {
+                histogram.record(std::chrono::microseconds(i % 100));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(histogram.snapshot().count(), 40000);
+    EXPECT_EQ(histogram.snapshot().max(), 99us);
+}
\ No newline at end of file
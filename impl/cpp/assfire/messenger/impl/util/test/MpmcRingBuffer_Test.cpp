@@ -0,0 +1,81 @@
+#include "assfire/messenger/impl/util/MpmcRingBuffer.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace assfire::messenger;
+
+TEST(MpmcRingBufferTest, CapacityIsRoundedUpToPowerOfTwo) {
+    EXPECT_EQ(MpmcRingBuffer<int>(5).capacity(), 8);
+    EXPECT_EQ(MpmcRingBuffer<int>(8).capacity(), 8);
+    EXPECT_EQ(MpmcRingBuffer<int>(0).capacity(), 2);
+}
+
+TEST(MpmcRingBufferTest, ValuesArePoppedInPushOrderWithPositions) {
+    MpmcRingBuffer<std::string> ring(4);
+    std::uint64_t position = 0;
+    EXPECT_TRUE(ring.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_push(std::to_string(i), position));
+        EXPECT_EQ(position, i);
+    }
+    EXPECT_FALSE(ring.try_push(std::string("overflow"), position));
+    EXPECT_EQ(ring.size(), 4);
+
+    std::string value;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value, position));
+        EXPECT_EQ(value, std::to_string(i));
+        EXPECT_EQ(position, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value, position));
+    EXPECT_TRUE(ring.empty());
+
+    ASSERT_TRUE(ring.try_push(std::string("wrapped"), position));
+    EXPECT_EQ(position, 4);
+}
+
+TEST(MpmcRingBufferTest, ConcurrentProducersAndConsumersTransferEveryValueOnce) {
+    constexpr int producers_count     = 3;
+    constexpr int consumers_count     = 3;
+    constexpr int values_per_producer  = 20000;
+    MpmcRingBuffer<int> ring(64);
+    std::vector<std::atomic<int>> received(producers_count * values_per_producer);
+    std::atomic<int> total_received(0);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers_count; ++p) {
+        threads.emplace_back([&, p] {
+            std::uint64_t position;
+            for (int i = 0; i < values_per_producer; ++i) {
+                while (!ring.try_push(p * values_per_producer + i, position)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers_count; ++c) {
+        threads.emplace_back([&] {
+            std::uint64_t position;
+            int value;
+            while (total_received.load() < producers_count * values_per_producer) {
+                if (ring.try_pop(value, position)) {
+                    received[value].fetch_add(1);
+                    total_received.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& count : received) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
\ No newline at end of file
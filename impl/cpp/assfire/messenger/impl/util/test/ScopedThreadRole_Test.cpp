@@ -0,0 +1,36 @@
+#include "assfire/messenger/impl/util/ScopedThreadRole.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace assfire::messenger;
+
+TEST(ScopedThreadRoleTest, RoleIsSetForScopeOnly) {
+    int owner = 0;
+    EXPECT_FALSE(ScopedThreadRole::current(&owner, 1));
+    {
+        ScopedThreadRole role(&owner, 1);
+        EXPECT_TRUE(ScopedThreadRole::current(&owner, 1));
+        EXPECT_FALSE(ScopedThreadRole::current(&owner, 2));
+    }
+    EXPECT_FALSE(ScopedThreadRole::current(&owner, 1));
+}
+
+TEST(ScopedThreadRoleTest, NestedRoleRestoresOuterOne) {
+    int owner       = 0;
+    int other_owner = 0;
+    ScopedThreadRole outer(&owner, 1);
+    {
+        ScopedThreadRole inner(&other_owner, 1);
+        EXPECT_FALSE(ScopedThreadRole::current(&owner, 1));
+        EXPECT_TRUE(ScopedThreadRole::current(&other_owner, 1));
+    }
+    EXPECT_TRUE(ScopedThreadRole::current(&owner, 1));
+}
+
+TEST(ScopedThreadRoleTest, RoleIsNotSeenByOtherThreads) {
+    int owner = 0;
+    ScopedThreadRole role(&owner, 1);
+    std::thread other([&] { EXPECT_FALSE(ScopedThreadRole::current(&owner, 1)); });
+    other.join();
+}
\ No newline at end of file
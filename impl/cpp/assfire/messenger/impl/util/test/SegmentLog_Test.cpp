@@ -0,0 +1,201 @@
+#include "assfire/messenger/impl/util/SegmentLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace assfire::messenger;
+
+namespace {
+    std::span<const std::uint8_t> bytes(const std::string& s) {
+        return std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(s.data()), s.size());
+    }
+
+    std::string to_string(const SegmentLog::Record& record) {
+        return std::string(reinterpret_cast<const char*>(record.data().data()), record.data().size());
+    }
+
+    std::size_t segment_files(const std::string& directory) {
+        return std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator());
+    }
+} // namespace
+
+class SegmentLogTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        directory = (std::filesystem::temp_directory_path() / ("assfire_segment_log_test." + std::to_string(getpid()))).string();
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string directory;
+};
+
+TEST_F(SegmentLogTest, RecordsAreReadInAppendOrderAcrossSegments) {
+    SegmentLog log(directory, 256, 16);
+    EXPECT_TRUE(log.empty());
+    EXPECT_FALSE(log.read());
+
+    for (int i = 0; i < 20; ++i) {
+        log.append(bytes("record " + std::to_string(i)));
+    }
+    EXPECT_FALSE(log.empty());
+    EXPECT_GT(log.segments_count(), 1);
+
+    for (int i = 0; i < 20; ++i) {
+        auto record = log.read();
+        ASSERT_TRUE(record);
+        EXPECT_EQ(to_string(*record), "record " + std::to_string(i));
+    }
+    EXPECT_FALSE(log.read());
+}
+
+TEST_F(SegmentLogTest, RewindReturnsToFirstUncommittedRecord) {
+    SegmentLog log(directory, 256, 16);
+    for (int i = 0; i < 5; ++i) {
+        log.append(bytes("record " + std::to_string(i)));
+    }
+
+    auto first = log.read();
+    log.read();
+    log.commit(*first);
+    log.read();
+
+    log.rewind();
+    auto record = log.read();
+    ASSERT_TRUE(record);
+    EXPECT_EQ(to_string(*record), "record 1");
+}
+
+TEST_F(SegmentLogTest, CommittedSegmentsAreRemoved) {
+    SegmentLog log(directory, 256, 16);
+    for (int i = 0; i < 20; ++i) {
+        log.append(bytes("record " + std::to_string(i)));
+    }
+    std::size_t segments = log.segments_count();
+    EXPECT_EQ(segment_files(directory), segments);
+
+    std::optional<SegmentLog::Record> last;
+    while (auto record = log.read()) {
+        last = record;
+    }
+    log.commit(*last);
+
+    EXPECT_TRUE(log.empty());
+    EXPECT_EQ(log.segments_count(), 1);
+    EXPECT_EQ(segment_files(directory), 1);
+}
+
+TEST_F(SegmentLogTest, AppendFailsWhenRecordDoesNotFitOrLogIsFull) {
+    SegmentLog log(directory, 256, 2);
+    EXPECT_THROW(log.append(bytes(std::string(log.max_record_size() + 1, 'x'))), std::runtime_error);
+
+    log.append(bytes(std::string(log.max_record_size(), 'x')));
+    log.append(bytes(std::string(log.max_record_size(), 'x')));
+    EXPECT_THROW(log.append(bytes("overflow")), std::runtime_error);
+
+    log.commit(*log.read());
+    EXPECT_NO_THROW(log.append(bytes("record")));
+}
+
+TEST_F(SegmentLogTest, BatchAppendStopsAtFirstRecordThatDoesNotFit) {
+    SegmentLog log(directory, 256, 2);
+    std::vector<std::vector<std::uint8_t>> records;
+    for (const std::string& record : {std::string("first"), std::string("second"), std::string(log.max_record_size(), 'x'),
+                                      std::string(log.max_record_size(), 'y'), std::string("last")}) {
+        records.emplace_back(record.begin(), record.end());
+    }
+
+    EXPECT_EQ(log.append_batch(records), 3);
+    EXPECT_EQ(to_string(*log.read()), "first");
+    EXPECT_EQ(to_string(*log.read()), "second");
+    EXPECT_EQ(to_string(*log.read()), std::string(log.max_record_size(), 'x'));
+    EXPECT_FALSE(log.read());
+}
+
+TEST_F(SegmentLogTest, UncommittedRecordsSurviveReopening) {
+    {
+        SegmentLog log(directory, 256, 16);
+        for (int i = 0; i < 20; ++i) {
+            log.append(bytes("record " + std::to_string(i)));
+        }
+        for (int i = 0; i < 7; ++i) {
+            log.commit(*log.read());
+        }
+    }
+
+    SegmentLog log(directory, 256, 16);
+    for (int i = 7; i < 20; ++i) {
+        auto record = log.read();
+        ASSERT_TRUE(record);
+        EXPECT_EQ(to_string(*record), "record " + std::to_string(i));
+    }
+    EXPECT_FALSE(log.read());
+
+    log.append(bytes("record 20"));
+    auto record = log.read();
+    ASSERT_TRUE(record);
+    EXPECT_EQ(to_string(*record), "record 20");
+}
+
+TEST_F(SegmentLogTest, TornRecordIsDroppedOnReopening) {
+    {
+        SegmentLog log(directory, 4096, 16);
+        log.append(bytes("record 0"));
+        log.append(bytes("record 1"));
+    }
+
+    // Corrupt the last byte of the second record
+    std::string path = std::filesystem::directory_iterator(directory)->path().string();
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(64 + 16 + 8 + 7);
+        file.put('X');
+    }
+
+    SegmentLog log(directory, 4096, 16);
+    auto record = log.read();
+    ASSERT_TRUE(record);
+    EXPECT_EQ(to_string(*record), "record 0");
+    EXPECT_FALSE(log.read());
+
+    log.append(bytes("record 2"));
+    record = log.read();
+    ASSERT_TRUE(record);
+    EXPECT_EQ(to_string(*record), "record 2");
+}
+
+TEST_F(SegmentLogTest, ConcurrentAppendsAreAllPersisted) {
+    constexpr int threads_count      = 4;
+    constexpr int records_per_thread = 200;
+    {
+        SegmentLog log(directory, 64 * 1024, 16);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < records_per_thread; ++i) {
+                    log.append(bytes(std::to_string(t) + ":" + std::to_string(i)));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    SegmentLog log(directory, 64 * 1024, 16);
+    std::vector<int> next(threads_count, 0);
+    while (auto record = log.read()) {
+        std::string value = to_string(*record);
+        int t             = std::stoi(value.substr(0, value.find(':')));
+        EXPECT_EQ(std::stoi(value.substr(value.find(':') + 1)), next[t]++);
+    }
+    EXPECT_EQ(next, std::vector<int>(threads_count, records_per_thread));
+}
\ No newline at end of file
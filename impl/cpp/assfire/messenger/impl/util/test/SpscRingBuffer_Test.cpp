@@ -0,0 +1,57 @@
+#include "assfire/messenger/impl/util/SpscRingBuffer.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using namespace assfire::messenger;
+
+TEST(SpscRingBufferTest, ValuesArePoppedInPushOrderWithPositions) {
+    SpscRingBuffer<std::string> ring(3);
+    std::uint64_t position = 0;
+    EXPECT_EQ(ring.capacity(), 4);
+    EXPECT_TRUE(ring.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_push(std::to_string(i), position));
+        EXPECT_EQ(position, i);
+    }
+    EXPECT_FALSE(ring.try_push(std::string("overflow"), position));
+    EXPECT_EQ(ring.size(), 4);
+
+    std::string value;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value, position));
+        EXPECT_EQ(value, std::to_string(i));
+        EXPECT_EQ(position, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value, position));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingBufferTest, ProducerAndConsumerThreadsKeepOrder) {
+    constexpr int values_count = 100000;
+    SpscRingBuffer<int> ring(16);
+
+    std::thread producer([&] {
+        std::uint64_t position;
+        for (int i = 0; i < values_count; ++i) {
+            while (!ring.try_push(i, position)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint64_t position;
+    int value;
+    for (int expected = 0; expected < values_count;) {
+        if (ring.try_pop(value, position)) {
+            ASSERT_EQ(value, expected);
+            ASSERT_EQ(position, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
\ No newline at end of file
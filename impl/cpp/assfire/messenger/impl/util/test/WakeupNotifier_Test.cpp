@@ -0,0 +1,65 @@
+#include "assfire/messenger/impl/util/WakeupNotifier.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace assfire::messenger;
+using namespace std::chrono_literals;
+
+TEST(WakeupNotifierTest, SatisfiedConditionReturnsImmediately) {
+    WakeupNotifier notifier;
+    EXPECT_TRUE(notifier.wait_for([] { return true; }, 0ms));
+}
+
+TEST(WakeupNotifierTest, WaitTimesOutWhenNotNotified) {
+    WakeupNotifier notifier(0);
+    auto started_at = std::chrono::steady_clock::now();
+    EXPECT_FALSE(notifier.wait_for([] { return false; }, 50ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - started_at, 50ms);
+}
+
+TEST(WakeupNotifierTest, ParkedWaiterIsWokenByNotify) {
+    WakeupNotifier notifier(0);
+    std::atomic_bool ready(false);
+
+    std::thread waiter([&] { EXPECT_TRUE(notifier.wait_for([&] { return ready.load(); }, 30s)); });
+    std::this_thread::sleep_for(20ms);
+    ready = true;
+    notifier.notify(1);
+    waiter.join();
+}
+
+TEST(WakeupNotifierTest, NotifyWakesRequestedNumberOfWaiters) {
+    WakeupNotifier notifier(0);
+    std::atomic<int> tokens(0);
+    std::atomic<int> woken(0);
+
+    auto take_token = [&] {
+        int available = tokens.load();
+        while (available > 0) {
+            if (tokens.compare_exchange_weak(available, available - 1)) { return true; }
+        }
+        return false;
+    };
+
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; ++i) {
+        waiters.emplace_back([&] {
+            if (notifier.wait_for(take_token, 30s)) { woken.fetch_add(1); }
+        });
+    }
+    std::this_thread::sleep_for(20ms);
+
+    tokens = 2;
+    notifier.notify(2);
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(woken.load(), 2);
+
+    tokens = 2;
+    notifier.notify_all();
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+    EXPECT_EQ(woken.load(), 4);
+}
\ No newline at end of file